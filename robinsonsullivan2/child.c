@@ -3,30 +3,76 @@
 // Date: 18 February 2026
 
 #include "child.h" 
+#include "primality.h"
+#include "sieve.h"
+#include "primeKernels.h"
+#include "searchPool.h"
+#include "progress.h"
+#include "checkpoint.h"
+#include "workload.h"
+#include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <signal.h>
 #include <time.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/timerfd.h>
 
 static int proc_num = -1;
 static unsigned long long highest_prime = 0;
+static volatile sig_atomic_t pending_io = 0; // Seconds of I/O requested by the scheduler
+static volatile sig_atomic_t resumed = 0;    // Set by SIGCONT once the scheduler runs us again
+static unsigned long long tested = 0;        // Candidates checked for primality
+static Sieve *thread_sieves = NULL;          // One sieve per pool thread with -t and -s
+static unsigned long long position = 0;      // First candidate the search has not finished (for -c)
+static unsigned long long resumed_tested = 0; // Candidates a resumed checkpoint had already tested
+static int checkpointing = 0;                // -c dir saves and resumes the search position
+static unsigned __int128 origin = 0;         // -w bits: 2^bits, and highest_prime and position are offsets from it
+static uint32_t wide_bits = 0;               // -w bits, 0 without -w (recorded in the checkpoint)
+static Workload work;                        // --kind: what the child spends its time on (default cpu, the prime search)
 
 /**************************************************
-Method Name: is_prime
-Returns: int
-Input: unsigned long long n
-Precondition: n is a positive integer
-Task: Determines whether n is a prime number.
+Method Name: highest_text
+Returns: const char *
+Input: N/A
+Precondition: N/A
+Task: Returns the highest prime in decimal. With -w it is above 2^64, so it
+      is formatted by hand from origin + offset; async-signal-safe.
  **************************************************/
-static int is_prime(unsigned long long n) {
-    if (n < 2) return 0;
-    if (n % 2 == 0) return n == 2;
-    for (unsigned long long d = 3; d * d <= n; d += 2) {
-        if (n % d == 0) return 0;
-    }
-    return 1;
+static const char *highest_text(void) {
+    static char buf[U128_DIGITS + 1];
+    return u128_to_string(highest_prime ? origin + highest_prime : 0, buf);
+}
+
+/**************************************************
+Method Name: save_checkpoint
+Returns: void
+Input: N/A
+Precondition: N/A
+Task: Writes the search position and counters to the -c checkpoint.
+      Async-signal-safe, so on_term can call it. Does nothing without -c.
+ **************************************************/
+static void save_checkpoint(void) {
+    Checkpoint c = { position, highest_prime, tested, wide_bits, (uint32_t)work.kind };
+    checkpoint_save(&c);
+}
+
+/**************************************************
+Method Name: tested_per_second
+Returns: double
+Input: N/A
+Precondition: N/A
+Task: Returns the candidates tested per second of CPU time used, so time
+      spent suspended or blocked on I/O does not lower the rate
+ **************************************************/
+static double tested_per_second(void) {
+    struct timespec cpu;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    double seconds = cpu.tv_sec + cpu.tv_nsec / 1e9;
+    return seconds > 0 ? (tested - resumed_tested) / seconds : 0.0;
 }
 
 /**************************************************
@@ -38,7 +84,7 @@ Task: Prints suspend message and stops the process
  **************************************************/
 static void on_tstp(int sig) {
     (void)sig;
-    printf("CHILD SUSPEND p=%d pid=%d highest=%llu\n", proc_num, getpid(), highest_prime);
+    printf("CHILD SUSPEND p=%d pid=%d highest=%s\n", proc_num, getpid(), highest_text());
     fflush(stdout);
     raise(SIGSTOP); // Stop the process
 }
@@ -52,7 +98,8 @@ Task: Prints resume message and continues execution
  **************************************************/
 static void on_cont(int sig) {
     (void)sig;
-    printf("CHILD RESUME p=%d pid=%d highest=%llu\n", proc_num, getpid(), highest_prime);
+    resumed = 1;
+    printf("CHILD RESUME p=%d pid=%d highest=%s\n", proc_num, getpid(), highest_text());
     fflush(stdout);
 }
 
@@ -61,15 +108,70 @@ Method Name: on_term
 Returns: void
 Input: int sig
 Precondition: Triggered by SIGTERM
-Task: Prints end message and ends the process
+Task: Prints end message (with the --kind work counters), saves the checkpoint (with -c) and ends the process
  **************************************************/
 static void on_term(int sig) {
     (void)sig;
-    printf("CHILD END p=%d pid=%d highest=%llu\n", proc_num, getpid(), highest_prime);
+    save_checkpoint();
+    char other[96];
+    workload_format(&work, other, sizeof(other));
+    printf("CHILD END p=%d pid=%d highest=%s tested=%llu rate=%.0f/s%s\n", proc_num, getpid(), highest_text(),
+           tested, tested_per_second(), other);
     fflush(stdout);
     _exit(0);
 }
 
+/**************************************************
+Method Name: on_io
+Returns: void
+Input: int sig, siginfo_t *info, void *ctx
+Precondition: Triggered by SIGUSR1 sent with sigqueue() carrying the I/O length in seconds
+Task: Records the I/O request so the main loop blocks for it
+ **************************************************/
+static void on_io(int sig, siginfo_t *info, void *ctx) {
+    (void)sig;
+    (void)ctx;
+    resumed = 0;
+    pending_io = info->si_value.sival_int;
+}
+
+/**************************************************
+Method Name: do_io
+Returns: void
+Input: N/A
+Precondition: pending_io holds the I/O length in seconds
+Task: Blocks on a timerfd for the I/O burst, then waits for SIGCONT
+      so the search only continues once the scheduler picks us again
+ **************************************************/
+static void do_io(void) {
+    int seconds = pending_io;
+    pending_io = 0;
+
+    printf("CHILD IO p=%d pid=%d seconds=%d highest=%s\n", proc_num, getpid(), seconds, highest_text());
+    fflush(stdout);
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (fd >= 0) {
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_sec = seconds;
+        timerfd_settime(fd, 0, &its, NULL);
+
+        // Block until the timer expires (signals may interrupt the read).
+        uint64_t expirations;
+        while (read(fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR) { }
+        close(fd);
+    }
+
+    // I/O is done, wait in the ready queue until the scheduler continues us.
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGCONT);
+    sigprocmask(SIG_BLOCK, &block, &old);
+    while (!resumed) sigsuspend(&old);
+    sigprocmask(SIG_SETMASK, &old, NULL);
+}
+
 /**************************************************
 Method Name: rand_10_digit
 Returns: unsigned long long
@@ -85,25 +187,454 @@ static unsigned long long rand_10_digit(void) {
     return 1000000000ULL + (c % 9000000000ULL); // [1,000,000,000 .. 9,999,999,999]
 }
 
+/**************************************************
+Method Name: search_sieve
+Returns: void
+Input: unsigned long long start
+Precondition: Signal handlers are installed
+Task: Searches upward from start one sieve segment at a time. highest_prime
+      and tested are updated at each segment boundary, so the signal
+      handlers report the last finished segment.
+ **************************************************/
+static void search_sieve(unsigned long long start) {
+    Sieve sieve;
+    // Base primes start at sqrt(4 * start) and are extended whenever the search outruns them.
+    if (sieve_init(&sieve, start, 4 * start, 0) < 0) {
+        fprintf(stderr, "child: cannot allocate the sieve\n");
+        exit(1);
+    }
+    while (1) {
+        if (pending_io) do_io();
+        uint64_t largest = 0;
+        uint64_t found = sieve.found;
+        uint64_t covered = sieve_segment(&sieve, &largest);
+        if (covered == 0) {
+            fprintf(stderr, "child: cannot extend the sieve\n");
+            exit(1);
+        }
+        if (largest > highest_prime) highest_prime = largest;
+        tested += covered;
+        position = sieve.low;
+        progress_add(covered, sieve.found - found, largest);
+        if (checkpoint_due()) save_checkpoint();
+    }
+}
+
+/**************************************************
+Method Name: filter_batch
+Returns: void
+Input: const PrimeKernels *kernels, Prefilter *filter
+Precondition: prefilter_init() was called on filter
+Task: One step of the default search: pre-filters the next 64 candidates,
+      runs Miller-Rabin on the survivors and publishes the batch.
+ **************************************************/
+static void filter_batch(const PrimeKernels *kernels, Prefilter *filter) {
+    uint64_t base = filter->next;
+    uint64_t alive = kernels->prefilter(filter);
+    uint64_t found = 0;
+    while (alive) {
+        uint64_t x = base + __builtin_ctzll(alive);
+        alive &= alive - 1;
+        if (miller_rabin_u64(x)) {
+            if (x > highest_prime) highest_prime = x;
+            found++;
+        }
+    }
+    tested += 64;
+    position = filter->next;
+    progress_add(64, found, highest_prime);
+    if (checkpoint_due()) save_checkpoint();
+}
+
+/**************************************************
+Method Name: filter_step
+Returns: void
+Input: void *arg
+Precondition: arg is an initialized Prefilter
+Task: filter_batch() with the best kernels, as the cpu step of --kind mixed.
+ **************************************************/
+static void filter_step(void *arg) {
+    filter_batch(kernels_best(), arg);
+}
+
+/**************************************************
+Method Name: run_workload
+Returns: void
+Input: unsigned long long start
+Precondition: Signal handlers are installed, work.kind is not cpu
+Task: --kind mem, cache, io or mixed: runs slices of the workload (for
+      mixed, in turn with slices of the prime search from start) and
+      still answers I/O bursts between slices. Never returns.
+ **************************************************/
+static void run_workload(unsigned long long start) {
+    Prefilter filter;
+    prefilter_init(&filter, start);
+    work.cpuStep = filter_step;
+    work.cpuArg = &filter;
+    if (workload_init(&work) < 0) {
+        fprintf(stderr, "child: cannot set up the %s workload\n", workload_name(work.kind));
+        exit(1);
+    }
+    while (1) {
+        if (pending_io) do_io();
+        workload_slice(&work, workload_next(&work));
+    }
+}
+
+/**************************************************
+Method Name: search_wide
+Returns: void
+Input: unsigned long long start
+Precondition: Signal handlers are installed, origin is set (-w)
+Task: The main search loop above 2^64: the same pre-filter, started from
+      origin + start, with Baillie-PSW on the survivors. highest_prime and
+      position stay 64-bit offsets from origin. Never returns.
+ **************************************************/
+static void search_wide(unsigned long long start) {
+    const PrimeKernels *kernels = kernels_best();
+    Prefilter filter;
+    prefilter_init_u128(&filter, origin + start);
+    uint64_t base = start;
+    while (1) {
+        if (pending_io) do_io();
+        uint64_t alive = kernels->prefilter(&filter);
+        uint64_t found = 0;
+        while (alive) {
+            uint64_t x = base + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (bpsw_u128(origin + x)) {
+                if (x > highest_prime) highest_prime = x;
+                found++;
+            }
+        }
+        base += 64;
+        tested += 64;
+        position = base;
+        progress_add(64, found, highest_prime);
+        if (checkpoint_due()) save_checkpoint();
+    }
+}
+
+/**************************************************
+Method Name: filter_range
+Returns: uint64_t
+Input: int thread, uint64_t from, uint64_t count, void *arg
+Precondition: arg is the PrimeKernels to use, count is a multiple of 64
+Task: Pool search for -t: pre-filters and Miller-Rabin tests
+      [from, from + count) and returns the largest prime (0 if none).
+ **************************************************/
+static uint64_t filter_range(int thread, uint64_t from, uint64_t count, void *arg) {
+    (void)thread;
+    const PrimeKernels *kernels = arg;
+    Prefilter filter;
+    prefilter_init(&filter, from);
+    uint64_t largest = 0, found = 0;
+    for (uint64_t done = 0; done < count; done += 64) {
+        uint64_t base = filter.next;
+        uint64_t alive = kernels->prefilter(&filter);
+        while (alive) {
+            uint64_t x = base + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (miller_rabin_u64(x)) {
+                largest = x;
+                found++;
+            }
+        }
+    }
+    progress_add(count, found, largest);
+    return largest;
+}
+
+/**************************************************
+Method Name: wide_range
+Returns: uint64_t
+Input: int thread, uint64_t from, uint64_t count, void *arg
+Precondition: arg is the PrimeKernels to use, count is a multiple of 64, origin is set (-w)
+Task: Pool search for -t -w: pre-filters origin + [from, from + count) and
+      tests the survivors with Baillie-PSW. Returns the offset of the
+      largest prime (0 if none; origin is even, so offset 0 is never prime).
+ **************************************************/
+static uint64_t wide_range(int thread, uint64_t from, uint64_t count, void *arg) {
+    (void)thread;
+    const PrimeKernels *kernels = arg;
+    Prefilter filter;
+    prefilter_init_u128(&filter, origin + from);
+    uint64_t largest = 0, found = 0;
+    for (uint64_t done = 0; done < count; done += 64) {
+        uint64_t alive = kernels->prefilter(&filter);
+        while (alive) {
+            uint64_t x = from + done + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (bpsw_u128(origin + x)) {
+                largest = x;
+                found++;
+            }
+        }
+    }
+    progress_add(count, found, largest);
+    return largest;
+}
+
+/**************************************************
+Method Name: sieve_range
+Returns: uint64_t
+Input: int thread, uint64_t from, uint64_t count, void *arg
+Precondition: thread_sieves[thread] is set up, count is a multiple of the segment span
+Task: Pool search for -t -s: sieves [from, from + count) with the
+      thread's own sieve and returns the largest prime (0 if none).
+ **************************************************/
+static uint64_t sieve_range(int thread, uint64_t from, uint64_t count, void *arg) {
+    (void)arg;
+    Sieve *sieve = &thread_sieves[thread];
+    sieve_seek(sieve, from);
+    uint64_t largest = 0, found = sieve->found;
+    for (uint64_t done = 0; done < count;) {
+        uint64_t covered = sieve_segment(sieve, &largest);
+        if (covered == 0) {
+            fprintf(stderr, "child: cannot extend the sieve\n");
+            _exit(1);
+        }
+        done += covered;
+    }
+    progress_add(count, sieve->found - found, largest);
+    return largest;
+}
+
+/**************************************************
+Method Name: threaded_signal
+Returns: void
+Input: int sig
+Precondition: Called on the signal thread with the pool running
+Task: Runs the normal handler for sig. For SIGTSTP and SIGTERM the pool is
+      parked first, so the highest prime, count and checkpoint position it
+      reports are settled and no thread searches while the process is suspended.
+ **************************************************/
+static void threaded_signal(int sig) {
+    if (sig != SIGCONT) {
+        pool_park();
+        position = pool_resume_point();
+    }
+    if (pool_highest() > highest_prime) highest_prime = pool_highest();
+    tested = resumed_tested + pool_tested();
+    if (sig == SIGTSTP) on_tstp(sig);
+    else if (sig == SIGCONT) on_cont(sig);
+    else on_term(sig);
+}
+
+/**************************************************
+Method Name: threaded_io
+Returns: void
+Input: int seconds, const sigset_t *handled
+Precondition: The pool is parked
+Task: do_io() for -t: waits out the I/O burst on the signal thread (still
+      answering signals), then waits for SIGCONT like do_io() does.
+ **************************************************/
+static void threaded_io(int seconds, const sigset_t *handled) {
+    highest_prime = pool_highest();
+    resumed = 0;
+    printf("CHILD IO p=%d pid=%d seconds=%d highest=%s\n", proc_num, getpid(), seconds, highest_text());
+    fflush(stdout);
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    end.tv_sec += seconds;
+    while (1) {
+        struct timespec now, left;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        left.tv_sec = end.tv_sec - now.tv_sec;
+        left.tv_nsec = end.tv_nsec - now.tv_nsec;
+        if (left.tv_nsec < 0) {
+            left.tv_sec--;
+            left.tv_nsec += 1000000000L;
+        }
+        if (left.tv_sec < 0) break;
+        int sig = sigtimedwait(handled, NULL, &left);
+        if (sig > 0 && sig != SIGUSR1) threaded_signal(sig);
+    }
+
+    while (!resumed) {
+        int sig = sigwaitinfo(handled, NULL);
+        if (sig > 0 && sig != SIGUSR1) threaded_signal(sig);
+    }
+}
+
+/**************************************************
+Method Name: search_threads
+Returns: void
+Input: int threads, unsigned long long start, int use_sieve
+Precondition: N/A
+Task: -t N: blocks all asynchronous signals, starts N pool threads that
+      take fixed-size ranges from work-stealing deques, and handles
+      every signal on this thread with sigwaitinfo(). With -c the pool is
+      parked to save a checkpoint CHECKPOINT_SECONDS after the last one,
+      however often signals wake this thread. Never returns.
+ **************************************************/
+static void search_threads(int threads, unsigned long long start, int use_sieve) {
+    sigset_t blocked;
+    sigfillset(&blocked);
+    sigdelset(&blocked, SIGSEGV);
+    sigdelset(&blocked, SIGBUS);
+    sigdelset(&blocked, SIGFPE);
+    sigdelset(&blocked, SIGILL);
+    pthread_sigmask(SIG_BLOCK, &blocked, NULL);
+
+    sigset_t handled;
+    sigemptyset(&handled);
+    sigaddset(&handled, SIGTSTP);
+    sigaddset(&handled, SIGCONT);
+    sigaddset(&handled, SIGTERM);
+    sigaddset(&handled, SIGINT);
+    sigaddset(&handled, SIGUSR1);
+
+    RangeSearch search = origin ? wide_range : filter_range;
+    void *arg = (void *)kernels_best();
+    uint64_t range_size = 1 << 16;
+    if (use_sieve) {
+        thread_sieves = calloc(threads, sizeof(Sieve));
+        for (int i = 0; thread_sieves && i < threads; i++) {
+            if (sieve_init(&thread_sieves[i], start, 4 * start, 0) < 0) {
+                free(thread_sieves);
+                thread_sieves = NULL;
+            }
+        }
+        if (!thread_sieves) {
+            fprintf(stderr, "child: cannot allocate the sieves\n");
+            exit(1);
+        }
+        search = sieve_range;
+        range_size = 16 * 128 * (uint64_t)thread_sieves[0].words; // 16 segments
+    }
+    if (pool_start(threads, start, range_size, search, arg) < 0) {
+        fprintf(stderr, "child: cannot start %d threads\n", threads);
+        exit(1);
+    }
+
+    int running = 1; // 0 between SIGTSTP and SIGCONT, while the pool stays parked
+    while (1) {
+        siginfo_t info;
+        struct timespec left;
+        if (checkpointing && !checkpoint_left(&left)) {
+            // Between SIGTSTP and SIGCONT the parked pool's position is already settled.
+            if (running) {
+                pool_park();
+                position = pool_resume_point();
+                if (pool_highest() > highest_prime) highest_prime = pool_highest();
+                tested = resumed_tested + pool_tested();
+            }
+            save_checkpoint();
+            if (running) pool_resume();
+            continue;
+        }
+        int sig = checkpointing ? sigtimedwait(&handled, &info, &left) : sigwaitinfo(&handled, &info);
+        if (sig == SIGUSR1) {
+            pool_park();
+            threaded_io(info.si_value.sival_int, &handled);
+            pool_resume();
+        } else if (sig > 0) {
+            threaded_signal(sig);
+            if (sig == SIGTSTP) running = 0;
+            if (sig == SIGCONT) {
+                running = 1;
+                pool_resume();
+            }
+        }
+    }
+}
+
 /**************************************************
 Method Name: main
 Returns: int
 Input: int argc, char **argv
-Precondition: Program must be run as ./child -p <process_number>
-Task: Complete Project
+Precondition: Program must be run as ./child -p <process_number> [-r seed] [-s | -w bits] [-t threads] [-m fd:slot] [-c dir]
+              [--kind cpu|mem|cache|io|mixed[:size]]
+Task: Complete Project. With -r the random start number comes from the given seed, so record/replay runs are reproducible.
+      With -s the search runs as a segmented sieve instead of testing each number, and -t spreads it over several threads.
+      -m publishes progress to the scheduler's shared progress page. -c keeps a checkpoint in dir/<process_number>.ckpt,
+      saved periodically and on SIGTERM, and a restarted child with the same number resumes from it. -w searches
+      2^bits + the random start with 128-bit Baillie-PSW tests; offsets from 2^bits are what -m and -c record.
+      --kind swaps the prime search for a memory, cache or I/O bound workload (workload.c), or rotates through all four.
  **************************************************/
 int main(int argc, char **argv) {
-    if (argc != 3 || strcmp(argv[1], "-p") != 0) {
-        fprintf(stderr, "Usage: %s -p <process_number>\n", argv[0]);
+    int opt;
+    int use_sieve = 0;
+    int threads = 0;
+    int bad = 0;
+    const char *seed = NULL;
+    const char *checkpoint_dir = NULL;
+    static const struct option long_options[] = {
+        { "kind", required_argument, NULL, 'k' },
+        { NULL, 0, NULL, 0 }
+    };
+    workload_parse("cpu", &work);
+    while ((opt = getopt_long(argc, argv, "p:r:st:m:c:w:k:", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'p':
+                proc_num = atoi(optarg);
+                break;
+            case 'r':
+                seed = optarg;
+                break;
+            case 's':
+                use_sieve = 1;
+                break;
+            case 't':
+                threads = atoi(optarg);
+                if (threads < 1 || threads > POOL_MAX_THREADS) bad = 1;
+                break;
+            case 'm':
+                if (progress_attach(optarg) < 0) fprintf(stderr, "child: cannot map progress record %s\n", optarg);
+                break;
+            case 'c':
+                checkpoint_dir = optarg;
+                break;
+            case 'w':
+                wide_bits = (uint32_t)atoi(optarg);
+                if (wide_bits < 64 || wide_bits > 127) bad = 1;
+                break;
+            case 'k':
+                if (workload_parse(optarg, &work) < 0) bad = 1;
+                break;
+            default:
+                bad = 1;
+                break;
+        }
+    }
+    // -s, -t and -w change how the prime search runs, so they only go with the cpu kind.
+    if (work.kind != WORK_CPU && (use_sieve || threads || wide_bits)) bad = 1;
+    if (bad || proc_num < 0 || optind != argc || (use_sieve && wide_bits)) {
+        fprintf(stderr, "Usage: %s -p <process_number> [-r seed] [-s | -w 64-127] [-t threads] [-m fd:slot] [-c dir] "
+                "[--kind cpu|mem|cache|io|mixed[:size]]\n", argv[0]);
         return 1;
     }
-    proc_num = atoi(argv[2]);
 
-    srand((unsigned)time(NULL) ^ (unsigned)getpid());
+    if (seed) srand((unsigned)strtoul(seed, NULL, 10));
+    else srand((unsigned)time(NULL) ^ (unsigned)getpid());
     unsigned long long start = rand_10_digit();
+    if (wide_bits) origin = (unsigned __int128)1 << wide_bits;
+    char start_text[U128_DIGITS + 1];
 
-    printf("CHILD START p=%d pid=%d rand=%llu\n", proc_num, getpid(), start);
+    Checkpoint saved;
+    if (checkpoint_dir) {
+        checkpointing = checkpoint_open(checkpoint_dir, proc_num) == 0;
+        if (!checkpointing) fprintf(stderr, "child: checkpoint path too long: %s\n", checkpoint_dir);
+    }
+    // A checkpoint from a search with other -w bits or another --kind counts from somewhere else.
+    int resuming = checkpointing && checkpoint_load(&saved);
+    if (resuming && (saved.wideBits != wide_bits || saved.kind != (uint32_t)work.kind)) {
+        fprintf(stderr, "child: ignoring a checkpoint saved with other -w or --kind options\n");
+        resuming = 0;
+    }
+    if (resuming) {
+        start = saved.position;
+        highest_prime = saved.highest;
+        tested = resumed_tested = saved.tested;
+        printf("CHILD START p=%d pid=%d resume=%s highest=%s tested=%llu\n", proc_num, getpid(),
+               u128_to_string(origin + start, start_text), highest_text(), tested);
+    } else {
+        printf("CHILD START p=%d pid=%d rand=%s\n", proc_num, getpid(), u128_to_string(origin + start, start_text));
+    }
     fflush(stdout);
+    position = start;
 
     struct sigaction sa;
     sigemptyset(&sa.sa_mask);
@@ -118,11 +649,23 @@ int main(int argc, char **argv) {
     sa.sa_handler = on_term;
     sigaction(SIGTERM, &sa, NULL);
 
-    unsigned long long x = start;
+    sa.sa_flags = SA_SIGINFO;
+    sa.sa_sigaction = on_io;
+    sigaction(SIGUSR1, &sa, NULL);
+
+    if (threads > 0) search_threads(threads, start, use_sieve);
+    if (use_sieve) search_sieve(start);
+    if (wide_bits) search_wide(start);
+    if (work.kind != WORK_CPU) run_workload(start);
+
+    // Rule out small factors 64 candidates at a time (SIMD where the CPU has it),
+    // then run Miller-Rabin on the survivors.
+    const PrimeKernels *kernels = kernels_best();
+    Prefilter filter;
+    prefilter_init(&filter, start);
     while (1) {
-        while (!is_prime(x)) x++;
-        if (x > highest_prime) highest_prime = x;
-        x++;
+        if (pending_io) do_io();
+        filter_batch(kernels, &filter);
     }
 }
 
@@ -0,0 +1,66 @@
+// File: eventDecode.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "eventLog.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+/**************************************************
+Method Name: main
+Returns: int
+Input: int argc, char **argv
+Precondition: Program must be run as ./eventDecode [-v] events.bin
+Task: Reads a binary scheduler event log and prints it in the
+      scheduler's text format. -v prefixes each line with the
+      monotonic time in milliseconds since the first event.
+ **************************************************/
+int main(int argc, char **argv) {
+    int verbose = 0;
+    const char *path = NULL;
+
+    if (argc == 3 && strcmp(argv[1], "-v") == 0) {
+        verbose = 1;
+        path = argv[2];
+    } else if (argc == 2) {
+        path = argv[1];
+    } else {
+        fprintf(stderr, "Usage: %s [-v] events.bin\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror("fopen");
+        return 1;
+    }
+
+    // Check the header: magic followed by the record size.
+    char magic[4];
+    uint32_t recordSize;
+    if (fread(magic, 1, 4, f) != 4 || memcmp(magic, EVENT_LOG_MAGIC, 4) != 0 ||
+        fread(&recordSize, sizeof(recordSize), 1, f) != 1 || recordSize != sizeof(Event)) {
+        fprintf(stderr, "%s is not an event log from this build\n", path);
+        fclose(f);
+        return 1;
+    }
+
+    Event ev;
+    uint64_t first = 0;
+    int haveFirst = 0;
+    char line[128];
+    while (fread(&ev, sizeof(ev), 1, f) == 1) {
+        if (!haveFirst) {
+            first = ev.timestampNs;
+            haveFirst = 1;
+        }
+        eventlog_format(&ev, line, sizeof(line));
+        if (verbose) printf("%10.3f ms  %s", (ev.timestampNs - first) / 1e6, line);
+        else fputs(line, stdout);
+    }
+
+    fclose(f);
+    return 0;
+}
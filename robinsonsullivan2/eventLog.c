@@ -0,0 +1,215 @@
+// File: eventLog.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "eventLog.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdatomic.h>
+
+#define RING_SIZE 4096 // Power of two so the index mask works
+#define FLUSH_BATCH 256
+
+// Single producer (the SIGALRM handler), single consumer (the main loop).
+static Event ring[RING_SIZE];
+static atomic_uint head = 0;        // Next slot the producer writes
+static atomic_uint tail = 0;        // Next slot the consumer reads
+static atomic_ulong dropped = 0;    // Events lost because the ring was full
+
+static int binFd = -1;              // Binary log file, -1 if not requested
+static int textOut = 1;             // 1 to decode events to stdout
+static void (*eventSink)(const Event *ev) = NULL; // Extra consumer (e.g. the trace), called per event
+
+/**************************************************
+Method Name: write_all
+Returns: void
+Input: int fd, const void *buf, size_t len
+Precondition: fd is open for writing
+Task: Writes the whole buffer, retrying on short writes.
+ **************************************************/
+static void write_all(int fd, const void *buf, size_t len) {
+    const char *p = buf;
+    while (len > 0) {
+        ssize_t w = write(fd, p, len);
+        if (w <= 0) return;
+        p += w;
+        len -= (size_t)w;
+    }
+}
+
+/**************************************************
+Method Name: eventlog_init
+Returns: int
+Input: const char *binPath, int text
+Precondition: binPath is a writable path or NULL
+Task: Opens the binary log (if binPath is given) and writes its header.
+  text selects whether flushed events are decoded to stdout.
+  Returns 0 on success, -1 if the log file cannot be opened.
+ **************************************************/
+int eventlog_init(const char *binPath, int text) {
+    textOut = text;
+    if (!binPath) return 0;
+
+    binFd = open(binPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (binFd < 0) {
+        perror("open event log");
+        return -1;
+    }
+
+    char header[8];
+    uint32_t recordSize = sizeof(Event);
+    memcpy(header, EVENT_LOG_MAGIC, 4);
+    memcpy(header + 4, &recordSize, 4);
+    write_all(binFd, header, sizeof(header));
+    return 0;
+}
+
+/**************************************************
+Method Name: eventlog_emit
+Returns: void
+Input: int type, int tick, int procNum, int pid, int value
+Precondition: Only one thread or signal handler produces events
+Task: Timestamps an event and pushes it onto the ring. Never blocks
+  or makes a write syscall, so it is safe in signal context. If the
+  ring is full the event is counted as dropped.
+ **************************************************/
+void eventlog_emit(int type, int tick, int procNum, int pid, int value) {
+    unsigned h = atomic_load_explicit(&head, memory_order_relaxed);
+    unsigned t = atomic_load_explicit(&tail, memory_order_acquire);
+    if (h - t >= RING_SIZE) {
+        atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    Event *ev = &ring[h & (RING_SIZE - 1)];
+    ev->timestampNs = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    ev->tick = tick;
+    ev->type = (uint16_t)type;
+    ev->reserved = 0;
+    ev->procNum = procNum;
+    ev->pid = pid;
+    ev->value = value;
+    ev->pad = 0;
+
+    // Publish the slot after it is fully written.
+    atomic_store_explicit(&head, h + 1, memory_order_release);
+}
+
+/**************************************************
+Method Name: eventlog_format
+Returns: int
+Input: const Event *ev, char *buf, size_t len
+Precondition: buf has room for len bytes
+Task: Decodes one event into the scheduler's text log line format.
+  Returns the number of characters written (like snprintf).
+ **************************************************/
+int eventlog_format(const Event *ev, char *buf, size_t len) {
+    switch (ev->type) {
+        case EV_START:
+            return snprintf(buf, len, "t=%d START p=%d pid=%d rem=%d\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        case EV_CONTINUE:
+            return snprintf(buf, len, "t=%d CONTINUE p=%d pid=%d rem=%d\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        case EV_PREEMPT:
+            return snprintf(buf, len, "t=%d PREEMPT p=%d pid=%d rem=%d\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        case EV_FINISH:
+            return snprintf(buf, len, "t=%d FINISH p=%d pid=%d\n", ev->tick, ev->procNum, ev->pid);
+        case EV_IO:
+            return snprintf(buf, len, "t=%d IO p=%d pid=%d io=%d\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        case EV_READY:
+            return snprintf(buf, len, "t=%d READY p=%d pid=%d rem=%d\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        case EV_COMPLETE:
+            return snprintf(buf, len, "Complete!\n");
+        case EV_ARRIVE:
+            return snprintf(buf, len, "t=%d ARRIVE p=%d\n", ev->tick, ev->procNum);
+        case EV_PROGRESS:
+            return snprintf(buf, len, "t=%d PROGRESS p=%d pid=%d rate=%dk/s\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        case EV_HANG:
+            return snprintf(buf, len, "t=%d HANG p=%d pid=%d stalled=%d\n", ev->tick, ev->procNum, ev->pid, ev->value);
+        default:
+            return snprintf(buf, len, "t=%d UNKNOWN(%d) p=%d pid=%d\n", ev->tick, ev->type, ev->procNum, ev->pid);
+    }
+}
+
+/**************************************************
+Method Name: eventlog_set_sink
+Returns: void
+Input: void (*sink)(const Event *ev)
+Precondition: N/A
+Task: Registers a function that eventlog_flush() calls for every event,
+  in order, from the main loop.
+ **************************************************/
+void eventlog_set_sink(void (*sink)(const Event *ev)) {
+    eventSink = sink;
+}
+
+/**************************************************
+Method Name: eventlog_flush
+Returns: void
+Input: N/A
+Precondition: Called from the main loop, never from signal context
+Task: Drains the ring in batches: one write() of binary records to the
+  log file and one write() of decoded text to stdout per batch.
+ **************************************************/
+void eventlog_flush(void) {
+    static Event batch[FLUSH_BATCH];
+    static char text[FLUSH_BATCH * 64];
+
+    while (1) {
+        unsigned t = atomic_load_explicit(&tail, memory_order_relaxed);
+        unsigned h = atomic_load_explicit(&head, memory_order_acquire);
+        unsigned count = h - t;
+        if (count == 0) return;
+        if (count > FLUSH_BATCH) count = FLUSH_BATCH;
+
+        for (unsigned i = 0; i < count; i++) {
+            batch[i] = ring[(t + i) & (RING_SIZE - 1)];
+        }
+        atomic_store_explicit(&tail, t + count, memory_order_release);
+
+        if (binFd >= 0) write_all(binFd, batch, count * sizeof(Event));
+
+        if (eventSink) {
+            for (unsigned i = 0; i < count; i++) eventSink(&batch[i]);
+        }
+
+        if (textOut) {
+            size_t used = 0;
+            for (unsigned i = 0; i < count; i++) {
+                int w = eventlog_format(&batch[i], text + used, sizeof(text) - used);
+                if (w > 0) used += (size_t)w < sizeof(text) - used ? (size_t)w : sizeof(text) - used - 1;
+            }
+            write_all(STDOUT_FILENO, text, used);
+        }
+    }
+}
+
+/**************************************************
+Method Name: eventlog_close
+Returns: void
+Input: N/A
+Precondition: No more events will be emitted
+Task: Flushes what is left in the ring and closes the binary log.
+ **************************************************/
+void eventlog_close(void) {
+    eventlog_flush();
+    if (binFd >= 0) close(binFd);
+    binFd = -1;
+}
+
+/**************************************************
+Method Name: eventlog_dropped
+Returns: unsigned long
+Input: N/A
+Precondition: N/A
+Task: Returns how many events were dropped because the ring was full.
+ **************************************************/
+unsigned long eventlog_dropped(void) {
+    return atomic_load_explicit(&dropped, memory_order_relaxed);
+}
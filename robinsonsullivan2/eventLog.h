@@ -0,0 +1,47 @@
+// File: eventLog.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Scheduler event types
+enum {
+    EV_START = 1,    // Process spawned and given the CPU
+    EV_CONTINUE,     // Process resumed or kept the CPU
+    EV_PREEMPT,      // Process stopped so another can run
+    EV_FINISH,       // Process terminated after its last burst
+    EV_IO,           // Process left the CPU for an I/O burst (value = I/O length)
+    EV_READY,        // Process finished its I/O burst and is ready again
+    EV_COMPLETE,     // All processes finished
+    EV_ARRIVE,       // Process arrived and became eligible to run
+    EV_PROGRESS,     // Running worker's progress record (value = thousands of numbers tested last tick)
+    EV_HANG          // Running worker's heartbeat stopped (value = ticks without one)
+};
+
+// One binary log record (32 bytes, written to disk as is)
+typedef struct {
+    uint64_t timestampNs; // CLOCK_MONOTONIC time the event was recorded
+    int32_t tick;         // Scheduler tick
+    uint16_t type;        // EV_* type
+    uint16_t reserved;
+    int32_t procNum;      // Logical process number (-1 if none)
+    int32_t pid;          // Child PID (0 if none)
+    int32_t value;        // Remaining time, I/O length for EV_IO, or as noted above
+    int32_t pad;
+} Event;
+
+#define EVENT_LOG_MAGIC "EVL1" // First 4 bytes of a binary log, followed by uint32 record size
+
+int eventlog_init(const char *binPath, int text);
+void eventlog_emit(int type, int tick, int procNum, int pid, int value);
+void eventlog_set_sink(void (*sink)(const Event *ev));
+void eventlog_flush(void);
+void eventlog_close(void);
+unsigned long eventlog_dropped(void);
+int eventlog_format(const Event *ev, char *buf, size_t len);
+
+#endif
@@ -0,0 +1,152 @@
+// File: kernelBench.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "primeKernels.h"
+#include "primality.h"
+#include "sieve.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_START 1234567891ULL // Where the searches start, like the workers
+#define BUFFER_WORDS 4096         // 32 KB for the OR and popcount runs
+
+typedef struct {
+    double prefilterRate; // Candidates per second through the small prime pre-filter
+    double searchRate;    // Candidates per second through pre-filter plus Miller-Rabin
+    double sieveRate;     // Integers per second covered by the sieve
+    double orRate;        // Bytes per second ORed
+    double popcountRate;  // Bytes per second counted
+    uint64_t survivors;   // Candidates the pre-filter let through
+    uint64_t primes;      // Primes found by the search
+    uint64_t sieved;      // Primes found by the sieve
+    uint64_t bits;        // Set bits counted
+} BenchResult;
+
+/**************************************************
+Method Name: now
+Returns: double
+Input: N/A
+Precondition: N/A
+Task: Returns the monotonic clock in seconds.
+ **************************************************/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**************************************************
+Method Name: bench_variant
+Returns: void
+Input: const PrimeKernels *k, int scale, BenchResult *r
+Precondition: k->supported() is true
+Task: Times every kernel of one variant on the same inputs.
+ **************************************************/
+static void bench_variant(const PrimeKernels *k, int scale, BenchResult *r) {
+    memset(r, 0, sizeof(*r));
+    int blocks = 20000 * scale;
+
+    // Pre-filter alone.
+    Prefilter filter;
+    prefilter_init(&filter, BENCH_START);
+    double t = now();
+    for (int b = 0; b < blocks; b++) r->survivors += __builtin_popcountll(k->prefilter(&filter));
+    r->prefilterRate = 64.0 * blocks / (now() - t);
+
+    // The workers' search loop: pre-filter, then Miller-Rabin on what is left.
+    prefilter_init(&filter, BENCH_START);
+    t = now();
+    for (int b = 0; b < blocks; b++) {
+        uint64_t base = filter.next;
+        uint64_t alive = k->prefilter(&filter);
+        while (alive) {
+            r->primes += miller_rabin_u64(base + __builtin_ctzll(alive));
+            alive &= alive - 1;
+        }
+    }
+    r->searchRate = 64.0 * blocks / (now() - t);
+
+    // Sieve segments, with this variant's pre-sieve and popcount.
+    Sieve sieve;
+    if (sieve_init(&sieve, BENCH_START, 4 * BENCH_START, 0) < 0) {
+        fprintf(stderr, "kernelBench: cannot allocate the sieve\n");
+        exit(1);
+    }
+    sieve.kernels = k;
+    uint64_t covered = 0, largest = 0;
+    t = now();
+    for (int i = 0; i < 200 * scale; i++) covered += sieve_segment(&sieve, &largest);
+    r->sieveRate = covered / (now() - t);
+    r->sieved = sieve.found;
+    sieve_free(&sieve);
+
+    // OR and popcount over an L1-sized buffer.
+    static uint64_t a[BUFFER_WORDS], b[BUFFER_WORDS];
+    for (int i = 0; i < BUFFER_WORDS; i++) {
+        a[i] = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+        b[i] = a[i] >> 7;
+    }
+    int rounds = 20000 * scale;
+    t = now();
+    for (int i = 0; i < rounds; i++) k->or_words(b, a, BUFFER_WORDS);
+    r->orRate = (double)rounds * sizeof(a) / (now() - t);
+    t = now();
+    for (int i = 0; i < rounds; i++) r->bits += k->popcount(a, BUFFER_WORDS);
+    r->popcountRate = (double)rounds * sizeof(a) / (now() - t);
+}
+
+/**************************************************
+Method Name: main
+Returns: int
+Input: int argc, char **argv
+Precondition: Run as ./kernelBench [scale]
+Task: Benchmarks every kernel variant this CPU supports against the
+  scalar one, checks that they all agree, and prints the speedups.
+  Exits with status 1 if any variant disagrees with the scalar kernels.
+ **************************************************/
+int main(int argc, char **argv) {
+    int scale = argc > 1 ? atoi(argv[1]) : 1;
+    if (argc > 2 || scale < 1) {
+        fprintf(stderr, "Usage: %s [scale]\n", argv[0]);
+        return 1;
+    }
+
+    // A plain is_prime_u64() loop over the same candidates, the pre-kernel baseline.
+    int blocks = 20000 * scale;
+    uint64_t basePrimes = 0;
+    double t = now();
+    for (uint64_t n = BENCH_START; n < BENCH_START + 64ULL * blocks; n++) basePrimes += is_prime_u64(n);
+    double baseRate = 64.0 * blocks / (now() - t);
+    printf("Runtime dispatch picks: %s\n", kernels_best()->name);
+    printf("is_prime_u64 loop: %.1f M candidates/s, %llu primes\n\n", baseRate / 1e6, (unsigned long long)basePrimes);
+
+    int count;
+    const PrimeKernels *all = kernels_all(&count);
+    BenchResult results[8];
+    const PrimeKernels *scalar = &all[count - 1];
+    bench_variant(scalar, scale, &results[count - 1]);
+    BenchResult *ref = &results[count - 1];
+
+    printf("%-8s %14s %14s %14s %10s %10s %8s\n", "kernels", "filter M/s", "search M/s", "sieve M/s", "or GB/s", "pop GB/s", "check");
+    int status = 0;
+    for (int i = 0; i < count; i++) {
+        if (!all[i].supported()) {
+            printf("%-8s (not supported on this CPU)\n", all[i].name);
+            continue;
+        }
+        BenchResult *r = &results[i];
+        if (i != count - 1) bench_variant(&all[i], scale, r);
+        int same = r->survivors == ref->survivors && r->primes == ref->primes && r->primes == basePrimes &&
+                   r->sieved == ref->sieved && r->bits == ref->bits;
+        if (!same) status = 1;
+        printf("%-8s %8.1f x%-4.1f %8.1f x%-4.1f %8.1f x%-4.1f %10.2f %10.2f %8s\n", all[i].name,
+               r->prefilterRate / 1e6, r->prefilterRate / ref->prefilterRate,
+               r->searchRate / 1e6, r->searchRate / ref->searchRate,
+               r->sieveRate / 1e6, r->sieveRate / ref->sieveRate,
+               r->orRate / 1e9, r->popcountRate / 1e9, same ? "ok" : "MISMATCH");
+    }
+    return status;
+}
@@ -0,0 +1,21 @@
+// File: primality.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef PRIMALITY_H
+#define PRIMALITY_H
+
+#include <stdint.h>
+
+int is_prime_u64(uint64_t n);
+int miller_rabin_u64(uint64_t n);
+uint64_t next_prime_u64(uint64_t n);
+
+// Wide search above 2^64 (-w): Baillie-PSW in 128-bit Montgomery form.
+#define U128_DIGITS 39 // Decimal digits of 2^128 - 1
+int is_prime_u128(unsigned __int128 n);
+int bpsw_u128(unsigned __int128 n);
+unsigned __int128 next_prime_u128(unsigned __int128 n);
+char *u128_to_string(unsigned __int128 n, char *buf);
+
+#endif
@@ -0,0 +1,447 @@
+// File: primeBench.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _GNU_SOURCE
+
+#include "primeKernels.h"
+#include "primality.h"
+#include "sieve.h"
+#include "progress.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
+
+#define MAX_RUNS 101
+#define MAX_STARTS 8
+#define MAX_WORKER_ARGS 16
+#define WORKER_TIMEOUT 5.0 // Seconds to wait for a worker's first prime
+#define SIEVE_MAX_ROOT (1ULL << 27) // Largest sqrt(limit) whose base prime table the sieves may build (~200 MB)
+
+// The search algorithms the workers have used, from slowest to fastest, then
+// the wide (-w) search above 2^64, which is the only one that runs there.
+enum { ALG_TRIAL, ALG_MR, ALG_SIMD_MR, ALG_SIEVE, ALG_SIMD_SIEVE, ALG_BPSW, ALG_SIMD_BPSW, ALG_COUNT };
+static const char *algNames[ALG_COUNT] = { "trial", "mr", "simd-mr", "sieve", "simd-sieve", "bpsw", "simd-bpsw" };
+
+typedef unsigned __int128 u128;
+
+// One timed run: how far the search got from its start in the time budget.
+typedef struct {
+    double seconds;
+    uint64_t candidates; // Numbers covered (tested one by one, or sieved)
+    uint64_t primes;     // Primes found among them
+} Run;
+
+/**************************************************
+Method Name: now
+Returns: double
+Input: N/A
+Precondition: N/A
+Task: Returns the monotonic clock in seconds.
+ **************************************************/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**************************************************
+Method Name: trial_division
+Returns: int
+Input: uint64_t n
+Precondition: N/A
+Task: The workers' original primality test: divides by every odd number
+  up to sqrt(n). Returns 1 if n is prime.
+ **************************************************/
+static int trial_division(uint64_t n) {
+    if (n < 2) return 0;
+    if (n % 2 == 0) return n == 2;
+    for (uint64_t d = 3; d <= n / d; d += 2) {
+        if (n % d == 0) return 0;
+    }
+    return 1;
+}
+
+/**************************************************
+Method Name: run_one_by_one
+Returns: Run
+Input: int (*test)(uint64_t), uint64_t start, double budget
+Precondition: N/A
+Task: Tests consecutive numbers from start with test() until the time
+  budget is spent. The clock is read every 64 numbers, and after every
+  number for trial division near 1e18 where one test can take seconds.
+ **************************************************/
+static Run run_one_by_one(int (*test)(uint64_t), uint64_t start, double budget) {
+    Run r = { 0, 0, 0 };
+    int step = test == trial_division && start > 1000000000000ULL ? 1 : 64;
+    double t = now(), end = t + budget;
+    uint64_t x = start;
+    do {
+        for (int i = 0; i < step; i++) r.primes += test(x++);
+        r.candidates += step;
+    } while (now() < end);
+    r.seconds = now() - t;
+    return r;
+}
+
+/**************************************************
+Method Name: run_prefilter
+Returns: Run
+Input: const PrimeKernels *k, uint64_t start, double budget
+Precondition: N/A
+Task: The workers' default search loop: the SIMD small prime pre-filter
+  over 64 candidates at a time, then Miller-Rabin on the survivors.
+ **************************************************/
+static Run run_prefilter(const PrimeKernels *k, uint64_t start, double budget) {
+    Run r = { 0, 0, 0 };
+    Prefilter filter;
+    prefilter_init(&filter, start);
+    double t = now(), end = t + budget;
+    do {
+        for (int b = 0; b < 16; b++) {
+            uint64_t base = filter.next;
+            uint64_t alive = k->prefilter(&filter);
+            while (alive) {
+                r.primes += miller_rabin_u64(base + __builtin_ctzll(alive));
+                alive &= alive - 1;
+            }
+        }
+        r.candidates += 16 * 64;
+    } while (now() < end);
+    r.seconds = now() - t;
+    return r;
+}
+
+/**************************************************
+Method Name: run_wide
+Returns: Run
+Input: const PrimeKernels *k, u128 start, double budget
+Precondition: start is above 2^64
+Task: The wide search: with k, the pre-filter then Baillie-PSW on the
+  survivors as in the workers' -w loop; without, is_prime_u128() on
+  every number.
+ **************************************************/
+static Run run_wide(const PrimeKernels *k, u128 start, double budget) {
+    Run r = { 0, 0, 0 };
+    Prefilter filter;
+    prefilter_init_u128(&filter, start);
+    double t = now(), end = t + budget;
+    do {
+        for (int b = 0; b < 16; b++, start += 64) {
+            if (!k) {
+                for (int i = 0; i < 64; i++) r.primes += is_prime_u128(start + i);
+                continue;
+            }
+            uint64_t alive = k->prefilter(&filter);
+            while (alive) {
+                r.primes += bpsw_u128(start + __builtin_ctzll(alive));
+                alive &= alive - 1;
+            }
+        }
+        r.candidates += 16 * 64;
+    } while (now() < end);
+    r.seconds = now() - t;
+    return r;
+}
+
+/**************************************************
+Method Name: run_sieve
+Returns: Run
+Input: Sieve *sieve, uint64_t start, double budget
+Precondition: sieve_init() covered everything the budget can reach
+Task: Sieves segments from start until the time budget is spent. The
+  base primes are built once outside the timed loop, as in the workers.
+ **************************************************/
+static Run run_sieve(Sieve *sieve, uint64_t start, double budget) {
+    Run r = { 0, 0, 0 };
+    uint64_t largest = 0;
+    sieve_seek(sieve, start);
+    uint64_t found = sieve->found;
+    double t = now(), end = t + budget;
+    do {
+        r.candidates += sieve_segment(sieve, &largest);
+    } while (now() < end);
+    r.seconds = now() - t;
+    r.primes = sieve->found - found;
+    return r;
+}
+
+/**************************************************
+Method Name: compare_doubles
+Returns: int
+Input: const void *a, const void *b
+Precondition: Both point to doubles
+Task: qsort order for doubles, smallest first.
+ **************************************************/
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**************************************************
+Method Name: median_variance
+Returns: void
+Input: double *values, int n, double *median, double *variance
+Precondition: n >= 1
+Task: Sorts values and returns their median and sample variance
+  (0 for a single value).
+ **************************************************/
+static void median_variance(double *values, int n, double *median, double *variance) {
+    qsort(values, n, sizeof(double), compare_doubles);
+    *median = n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+    double mean = 0, sum = 0;
+    for (int i = 0; i < n; i++) mean += values[i] / n;
+    for (int i = 0; i < n; i++) sum += (values[i] - mean) * (values[i] - mean);
+    *variance = n > 1 ? sum / (n - 1) : 0;
+}
+
+/**************************************************
+Method Name: cpu_name
+Returns: void
+Input: char *buf, size_t len
+Precondition: N/A
+Task: Names this CPU for the CSV: the model name from /proc/cpuinfo,
+  or the machine type from uname. Commas are replaced with spaces.
+ **************************************************/
+static void cpu_name(char *buf, size_t len) {
+    struct utsname u;
+    snprintf(buf, len, "%s", uname(&u) == 0 ? u.machine : "unknown");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f) {
+        char line[256];
+        while (fgets(line, sizeof(line), f)) {
+            char *colon = strchr(line, ':');
+            if (colon && strncmp(line, "model name", 10) == 0) {
+                colon += strspn(colon + 1, " \t") + 1;
+                colon[strcspn(colon, "\n")] = '\0';
+                snprintf(buf, len, "%s", colon);
+                break;
+            }
+        }
+        fclose(f);
+    }
+    for (char *c = buf; *c; c++) {
+        if (*c == ',') *c = ' ';
+    }
+}
+
+/**************************************************
+Method Name: parse_starts
+Returns: int
+Input: const char *list, u128 *starts
+Precondition: starts has room for MAX_STARTS values
+Task: Reads a comma separated list of powers of ten or of two (e.g.
+  9,12,15,18,2^64,2^80) into start numbers, all below 2^127. Returns how
+  many there are, or 0 if the list is bad.
+ **************************************************/
+static int parse_starts(const char *list, u128 *starts) {
+    int n = 0;
+    while (*list) {
+        char *end;
+        int two = strncmp(list, "2^", 2) == 0;
+        long e = strtol(list + 2 * two, &end, 10);
+        if (end == list + 2 * two || e < 1 || e > (two ? 126 : 38) || n == MAX_STARTS) return 0;
+        starts[n] = 1;
+        while (e-- > 0) starts[n] *= two ? 2 : 10;
+        n++;
+        list = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') return 0;
+    }
+    return n;
+}
+
+/**************************************************
+Method Name: worker_first_prime
+Returns: double
+Input: char **args, int n, int progressFd
+Precondition: args holds the worker command in n entries with two free
+  slots after them, progressFd came from progress_create(1)
+Task: Starts the worker with -m progressFd:0 and its output discarded,
+  and waits for its progress record to report a prime. Returns the time
+  from fork to the first prime in microseconds, or -1 if the worker did
+  not find one within WORKER_TIMEOUT seconds. The worker is killed after.
+ **************************************************/
+static double worker_first_prime(char **args, int n, int progressFd) {
+    char spec[32];
+    snprintf(spec, sizeof(spec), "%d:0", progressFd);
+    args[n] = "-m";
+    args[n + 1] = spec;
+    args[n + 2] = NULL;
+
+    const ProgressRecord *record = progress_record(0);
+    uint64_t before = atomic_load_explicit(&record->found, memory_order_relaxed);
+    double t = now();
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) dup2(null, STDOUT_FILENO);
+        execv(args[0], args);
+        _exit(127);
+    }
+
+    // Poll with short sleeps so the worker gets the CPU on a single core machine.
+    double elapsed = -1;
+    struct timespec nap = { 0, 10000 };
+    while (now() - t < WORKER_TIMEOUT) {
+        if (atomic_load_explicit(&record->found, memory_order_relaxed) != before) {
+            elapsed = (now() - t) * 1e6;
+            break;
+        }
+        if (waitpid(pid, NULL, WNOHANG) == pid) return -1;
+        nanosleep(&nap, NULL);
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, NULL, 0);
+    return elapsed;
+}
+
+/**************************************************
+Method Name: bench_startup
+Returns: int
+Input: const char *command, int runs, const char *cpu
+Precondition: command is a worker command line such as "./prime 1 1"
+Task: -w: measures the worker's startup-to-first-prime latency runs times
+  and writes a CSV row with its median and variance in microseconds.
+  Returns 0, or 1 if the worker never reported a prime.
+ **************************************************/
+static int bench_startup(const char *command, int runs, const char *cpu) {
+    char line[256];
+    char *args[MAX_WORKER_ARGS + 3];
+    int n = 0;
+    snprintf(line, sizeof(line), "%s", command);
+    for (char *word = strtok(line, " "); word && n < MAX_WORKER_ARGS; word = strtok(NULL, " ")) args[n++] = word;
+    int progressFd = n > 0 ? progress_create(1) : -1;
+    if (progressFd < 0) {
+        fprintf(stderr, "primeBench: cannot set up a progress page for %s\n", command);
+        return 1;
+    }
+
+    double latencies[MAX_RUNS];
+    for (int i = 0; i < runs; i++) {
+        latencies[i] = worker_first_prime(args, n, progressFd);
+        if (latencies[i] < 0) {
+            fprintf(stderr, "primeBench: %s reported no prime (does it take -m fd:slot?)\n", command);
+            return 1;
+        }
+    }
+    double median, variance;
+    median_variance(latencies, runs, &median, &variance);
+    printf("cpu,compiler,worker,runs,first_prime_us_median,first_prime_us_variance,status\n");
+    printf("%s,%s,%s,%d,%.1f,%.1f,ok\n", cpu, __VERSION__, command, runs, median, variance);
+    return 0;
+}
+
+/**************************************************
+Method Name: main
+Returns: int
+Input: int argc, char **argv
+Precondition: Run as ./primeBench [-r runs] [-b seconds] [-m 9,12,15,18,2^64]
+  or ./primeBench [-r runs] -w "worker command"
+Task: Times every search algorithm from each start magnitude, repeating
+  each measurement runs times, and writes one CSV row per algorithm and
+  start with the median and variance of candidates and primes per second.
+  Algorithms that cannot run at a magnitude get a row with status skipped.
+  With -w it measures the worker's startup-to-first-prime latency instead.
+ **************************************************/
+int main(int argc, char **argv) {
+    int runs = 5;
+    double budget = 0.25;
+    u128 starts[MAX_STARTS] = { 1000000000ULL, 1000000000000ULL, 1000000000000000ULL, 1000000000000000000ULL,
+                                (u128)1 << 64, (u128)1 << 72, (u128)1 << 80 };
+    int nStarts = 7;
+    const char *worker = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "r:b:m:w:")) != -1) {
+        switch (opt) {
+        case 'r':
+            runs = atoi(optarg);
+            break;
+        case 'b':
+            budget = atof(optarg);
+            break;
+        case 'm':
+            nStarts = parse_starts(optarg, starts);
+            break;
+        case 'w':
+            worker = optarg;
+            break;
+        default:
+            nStarts = 0;
+            break;
+        }
+    }
+    if (optind != argc || runs < 1 || runs > MAX_RUNS || budget <= 0 || nStarts == 0) {
+        fprintf(stderr, "Usage: %s [-r runs] [-b seconds per run] [-m 9,12,15,18,2^64,2^72,2^80]\n", argv[0]);
+        fprintf(stderr, "       %s [-r runs] -w \"worker command\"\n", argv[0]);
+        return 1;
+    }
+    char cpu[128];
+    cpu_name(cpu, sizeof(cpu));
+    if (worker) return bench_startup(worker, runs, cpu);
+
+    int count;
+    const PrimeKernels *all = kernels_all(&count);
+    const PrimeKernels *scalar = &all[count - 1], *best = kernels_best();
+
+    printf("cpu,compiler,algorithm,kernels,start,runs,seconds,candidates_per_s_median,candidates_per_s_variance,"
+           "primes_per_s_median,primes_per_s_variance,primes,status\n");
+    for (int s = 0; s < nStarts; s++) {
+        char startText[U128_DIGITS + 1];
+        u128_to_string(starts[s], startText);
+        int wideStart = (starts[s] >> 64) != 0;
+        uint64_t start = (uint64_t)starts[s] | 1;
+        for (int alg = 0; alg < ALG_COUNT; alg++) {
+            int wideAlg = alg == ALG_BPSW || alg == ALG_SIMD_BPSW;
+            const PrimeKernels *k = alg == ALG_SIMD_MR || alg == ALG_SIMD_SIEVE || alg == ALG_SIMD_BPSW ? best : scalar;
+            const char *kernels = alg == ALG_TRIAL || alg == ALG_MR || alg == ALG_BPSW ? "none" : k->name;
+
+            // The sieves cover up to twice the start (plus slack for 1e9), so their base
+            // primes only have to be built once.
+            Sieve sieve;
+            int sieving = alg == ALG_SIEVE || alg == ALG_SIMD_SIEVE;
+            uint64_t limit = start > UINT64_MAX / 2 - (1ULL << 32) ? UINT64_MAX - 1 : 2 * start + (1ULL << 32);
+            int skip = wideAlg != wideStart;
+            if (sieving && !skip) {
+                skip = (double)limit > (double)SIEVE_MAX_ROOT * SIEVE_MAX_ROOT || sieve_init(&sieve, start, limit, 0) < 0;
+                sieve.kernels = k;
+            }
+            if (skip) {
+                printf("%s,%s,%s,%s,%s,0,0,0,0,0,0,0,skipped\n", cpu, __VERSION__, algNames[alg], kernels, startText);
+                fflush(stdout);
+                continue;
+            }
+
+            double rates[MAX_RUNS], primeRates[MAX_RUNS], seconds = 0;
+            uint64_t primes = 0;
+            for (int i = 0; i < runs; i++) {
+                Run r;
+                if (alg == ALG_TRIAL) r = run_one_by_one(trial_division, start, budget);
+                else if (alg == ALG_MR) r = run_one_by_one(is_prime_u64, start, budget);
+                else if (alg == ALG_SIMD_MR) r = run_prefilter(k, start, budget);
+                else if (wideAlg) r = run_wide(alg == ALG_SIMD_BPSW ? k : NULL, starts[s] | 1, budget);
+                else r = run_sieve(&sieve, start, budget);
+                rates[i] = r.candidates / r.seconds;
+                primeRates[i] = r.primes / r.seconds;
+                seconds += r.seconds;
+                primes += r.primes;
+            }
+            if (sieving) sieve_free(&sieve);
+
+            double rateMedian, rateVariance, primeMedian, primeVariance;
+            median_variance(rates, runs, &rateMedian, &rateVariance);
+            median_variance(primeRates, runs, &primeMedian, &primeVariance);
+            printf("%s,%s,%s,%s,%s,%d,%.3f,%.6g,%.6g,%.6g,%.6g,%llu,ok\n", cpu, __VERSION__, algNames[alg], kernels,
+                   startText, runs, seconds, rateMedian, rateVariance, primeMedian, primeVariance,
+                   (unsigned long long)primes);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+// File: primeKernels.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef PRIME_KERNELS_H
+#define PRIME_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PREFILTER_PRIMES 46 // 2 and the odd primes below 200
+#define PREFILTER_LANES 48  // Rounded up to whole vectors; extra lanes repeat the prime 3
+
+// Residue of the next candidate modulo each small prime. Stepping a
+// candidate adds 1 to every lane and wraps at the prime, so no division is
+// needed once the residues are set up.
+typedef struct {
+    uint32_t primes[PREFILTER_LANES] __attribute__((aligned(64)));
+    uint32_t residues[PREFILTER_LANES] __attribute__((aligned(64)));
+    uint64_t next; // Candidate the residues belong to
+} Prefilter;
+
+// One implementation of each inner loop. Every variant gives the same results.
+typedef struct {
+    const char *name;
+    int (*supported)(void);
+    // Returns a mask of the 64 candidates from f->next on (bit i = f->next + i)
+    // that no small prime divides, and advances f by 64.
+    uint64_t (*prefilter)(Prefilter *f);
+    // dst[i] |= src[i] for n words (sieve pre-marking from a repeating pattern).
+    void (*or_words)(uint64_t *dst, const uint64_t *src, size_t n);
+    // Number of set bits in n words.
+    uint64_t (*popcount)(const uint64_t *words, size_t n);
+} PrimeKernels;
+
+void prefilter_init(Prefilter *f, uint64_t start);
+void prefilter_init_u128(Prefilter *f, unsigned __int128 start);
+const PrimeKernels *kernels_best(void);
+const PrimeKernels *kernels_all(int *count);
+
+#endif
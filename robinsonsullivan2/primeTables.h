@@ -0,0 +1,102 @@
+// File: primeTables.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+// Generated by genTables.c, do not edit. To regenerate:
+//   gcc genTables.c -o genTables && ./genTables > primeTables.h
+
+#ifndef PRIME_TABLES_H
+#define PRIME_TABLES_H
+
+#include <stdint.h>
+
+// Divisibility by an odd prime p without a division: n is a multiple of p
+// exactly when n * p^-1 (mod 2^64) <= (2^64 - 1) / p.
+typedef struct {
+    uint64_t p;
+    uint64_t inverse;
+    uint64_t limit;
+} SmallPrime;
+
+#define SMALL_PRIME_COUNT 45
+static const SmallPrime smallPrimeTable[SMALL_PRIME_COUNT] = {
+    {   3, 0xaaaaaaaaaaaaaaabULL, 0x5555555555555555ULL },
+    {   5, 0xcccccccccccccccdULL, 0x3333333333333333ULL },
+    {   7, 0x6db6db6db6db6db7ULL, 0x2492492492492492ULL },
+    {  11, 0x2e8ba2e8ba2e8ba3ULL, 0x1745d1745d1745d1ULL },
+    {  13, 0x4ec4ec4ec4ec4ec5ULL, 0x13b13b13b13b13b1ULL },
+    {  17, 0xf0f0f0f0f0f0f0f1ULL, 0x0f0f0f0f0f0f0f0fULL },
+    {  19, 0x86bca1af286bca1bULL, 0x0d79435e50d79435ULL },
+    {  23, 0xd37a6f4de9bd37a7ULL, 0x0b21642c8590b216ULL },
+    {  29, 0x34f72c234f72c235ULL, 0x08d3dcb08d3dcb08ULL },
+    {  31, 0xef7bdef7bdef7bdfULL, 0x0842108421084210ULL },
+    {  37, 0x14c1bacf914c1badULL, 0x06eb3e45306eb3e4ULL },
+    {  41, 0x8f9c18f9c18f9c19ULL, 0x063e7063e7063e70ULL },
+    {  43, 0x82fa0be82fa0be83ULL, 0x05f417d05f417d05ULL },
+    {  47, 0x51b3bea3677d46cfULL, 0x0572620ae4c415c9ULL },
+    {  53, 0x21cfb2b78c13521dULL, 0x04d4873ecade304dULL },
+    {  59, 0xcbeea4e1a08ad8f3ULL, 0x0456c797dd49c341ULL },
+    {  61, 0x4fbcda3ac10c9715ULL, 0x04325c53ef368eb0ULL },
+    {  67, 0xf0b7672a07a44c6bULL, 0x03d226357e16ece5ULL },
+    {  71, 0x193d4bb7e327a977ULL, 0x039b0ad12073615aULL },
+    {  73, 0x7e3f1f8fc7e3f1f9ULL, 0x0381c0e070381c0eULL },
+    {  79, 0x9b8b577e613716afULL, 0x033d91d2a2067b23ULL },
+    {  83, 0xa3784a062b2e43dbULL, 0x03159721ed7e7534ULL },
+    {  89, 0xf47e8fd1fa3f47e9ULL, 0x02e05c0b81702e05ULL },
+    {  97, 0xa3a0fd5c5f02a3a1ULL, 0x02a3a0fd5c5f02a3ULL },
+    { 101, 0x3a4c0a237c32b16dULL, 0x0288df0cac5b3f5dULL },
+    { 103, 0xdab7ec1dd3431b57ULL, 0x027c45979c95204fULL },
+    { 107, 0x77a04c8f8d28ac43ULL, 0x02647c69456217ecULL },
+    { 109, 0xa6c0964fda6c0965ULL, 0x02593f69b02593f6ULL },
+    { 113, 0x90fdbc090fdbc091ULL, 0x0243f6f0243f6f02ULL },
+    { 127, 0x7efdfbf7efdfbf7fULL, 0x0204081020408102ULL },
+    { 131, 0x03e88cb3c9484e2bULL, 0x01f44659e4a42715ULL },
+    { 137, 0xe21a291c077975b9ULL, 0x01de5d6e3f8868a4ULL },
+    { 139, 0x3aef6ca970586723ULL, 0x01d77b654b82c339ULL },
+    { 149, 0xdf5b0f768ce2cabdULL, 0x01b7d6c3dda338b2ULL },
+    { 151, 0x6fe4dfc9bf937f27ULL, 0x01b2036406c80d90ULL },
+    { 157, 0x5b4fe5e92c0685b5ULL, 0x01a16d3f97a4b01aULL },
+    { 163, 0x1f693a1c451ab30bULL, 0x01920fb49d0e228dULL },
+    { 167, 0x8d07aa27db35a717ULL, 0x01886e5f0abb0499ULL },
+    { 173, 0x882383b30d516325ULL, 0x017ad2208e0ecc35ULL },
+    { 179, 0xed6866f8d962ae7bULL, 0x016e1f76b4337c6cULL },
+    { 181, 0x3454dca410f8ed9dULL, 0x016a13cd15372904ULL },
+    { 191, 0x1d7ca632ee936f3fULL, 0x01571ed3c506b39aULL },
+    { 193, 0x70bf015390948f41ULL, 0x015390948f40feacULL },
+    { 197, 0xc96bdb9d3d137e0dULL, 0x014cab88725af6e7ULL },
+    { 199, 0x2697cc8aef46c0f7ULL, 0x0149539e3b2d066eULL },
+};
+
+// Pre-filter lanes: 2 and the odd primes below 200, padded with 3 to whole vectors.
+static const uint32_t prefilterPrimeTable[48] = {
+    2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+    59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
+    137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 3, 3,
+};
+
+// Odd primes below 64 that the sieve pre-marks, with 64^-1 mod p.
+static const uint32_t presievePrimeTable[17][2] = {
+    { 3, 1 }, { 5, 4 }, { 7, 1 }, { 11, 5 }, { 13, 12 }, { 17, 4 },
+    { 19, 11 }, { 23, 9 }, { 29, 5 }, { 31, 16 }, { 37, 11 }, { 41, 25 },
+    { 43, 41 }, { 47, 36 }, { 53, 29 }, { 59, 12 }, { 61, 41 },
+};
+
+// Mod 210 wheel: for every residue r, the distance to the next residue at or
+// after r that is coprime to 2, 3, 5 and 7 (48 of the 210 are).
+#define WHEEL_MODULUS 210
+static const uint8_t wheelAdvance[WHEEL_MODULUS] = {
+    1, 0, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 1, 0, 3, 2, 1, 0, 1, 0, 3,
+    2, 1, 0, 5, 4, 3, 2, 1, 0, 1, 0, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0,
+    1, 0, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0, 1, 0, 5,
+    4, 3, 2, 1, 0, 3, 2, 1, 0, 1, 0, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0,
+    5, 4, 3, 2, 1, 0, 7, 6, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0, 1, 0, 3,
+    2, 1, 0, 1, 0, 3, 2, 1, 0, 7, 6, 5, 4, 3, 2, 1, 0, 5, 4, 3, 2,
+    1, 0, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0, 1, 0, 3, 2, 1, 0, 5, 4, 3,
+    2, 1, 0, 1, 0, 5, 4, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0,
+    1, 0, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0, 1, 0, 5, 4, 3, 2, 1, 0, 3,
+    2, 1, 0, 1, 0, 3, 2, 1, 0, 1, 0, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+};
+
+// Miller-Rabin witnesses with no false positives below 2^64.
+static const uint64_t millerRabinWitnesses[7] = { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+
+#endif
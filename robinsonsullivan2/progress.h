@@ -0,0 +1,33 @@
+// File: progress.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+// Counters for the workload kinds other than the prime search (workload.c).
+enum { PROGRESS_STREAMED, PROGRESS_HOPS, PROGRESS_SYNCS, PROGRESS_WORK };
+
+// One worker's progress, in a memfd shared between the scheduler and its
+// children. The worker only adds to it and the scheduler only reads it
+// (unless it runs the jobs itself, --fibers), both with relaxed atomics;
+// each record has its own cache line.
+typedef struct {
+    _Atomic uint64_t highest;   // Highest prime found so far
+    _Atomic uint64_t tested;    // Candidates tested
+    _Atomic uint64_t found;     // Primes found
+    _Atomic uint64_t heartbeat; // Bumped with every update; stops moving if the worker hangs
+    _Atomic uint64_t work[PROGRESS_WORK]; // Other workload kinds (--kind): bytes streamed, pointer hops, synced writes
+} __attribute__((aligned(64))) ProgressRecord;
+
+int progress_create(int slots);
+const ProgressRecord *progress_record(int slot);
+int progress_attach(const char *spec);
+void progress_use(int slot);
+void progress_add(uint64_t tested, uint64_t found, uint64_t largest);
+void progress_work(int counter, uint64_t units);
+
+#endif
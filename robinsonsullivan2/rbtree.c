@@ -0,0 +1,299 @@
+// File: rbtree.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "rbtree.h"
+
+#include <stddef.h>
+
+/**************************************************
+Method Name: node_less
+Returns: int
+Input: const RbNode *a, const RbNode *b
+Precondition: a and b are valid nodes
+Task: Orders nodes by key, then by id so equal keys stay deterministic.
+ **************************************************/
+static int node_less(const RbNode *a, const RbNode *b) {
+    if (a->key != b->key) return a->key < b->key;
+    return a->id < b->id;
+}
+
+/**************************************************
+Method Name: rotate_left
+Returns: void
+Input: RbTree *tree, RbNode *x
+Precondition: x->right is not NULL
+Task: Rotates x down to the left so its right child takes its place.
+ **************************************************/
+static void rotate_left(RbTree *tree, RbNode *x) {
+    RbNode *y = x->right;
+
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+
+    if (!x->parent) tree->root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+
+    y->left = x;
+    x->parent = y;
+}
+
+/**************************************************
+Method Name: rotate_right
+Returns: void
+Input: RbTree *tree, RbNode *x
+Precondition: x->left is not NULL
+Task: Rotates x down to the right so its left child takes its place.
+ **************************************************/
+static void rotate_right(RbTree *tree, RbNode *x) {
+    RbNode *y = x->left;
+
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+
+    if (!x->parent) tree->root = y;
+    else if (x == x->parent->right) x->parent->right = y;
+    else x->parent->left = y;
+
+    y->right = x;
+    x->parent = y;
+}
+
+/**************************************************
+Method Name: rb_init
+Returns: void
+Input: RbTree *tree
+Precondition: tree points to writable memory
+Task: Initializes an empty tree.
+ **************************************************/
+void rb_init(RbTree *tree) {
+    tree->root = NULL;
+    tree->leftmost = NULL;
+}
+
+/**************************************************
+Method Name: rb_insert
+Returns: void
+Input: RbTree *tree, RbNode *node
+Precondition: node->key and node->id are set, node is not in a tree
+Task: Inserts node and rebalances the tree. Updates the cached leftmost node.
+ **************************************************/
+void rb_insert(RbTree *tree, RbNode *node) {
+    RbNode *parent = NULL;
+    RbNode *cur = tree->root;
+    int leftmost = 1;
+
+    // Walk down to the insertion point.
+    while (cur) {
+        parent = cur;
+        if (node_less(node, cur)) {
+            cur = cur->left;
+        } else {
+            cur = cur->right;
+            leftmost = 0;
+        }
+    }
+
+    node->parent = parent;
+    node->left = NULL;
+    node->right = NULL;
+    node->red = 1;
+
+    if (!parent) tree->root = node;
+    else if (node_less(node, parent)) parent->left = node;
+    else parent->right = node;
+
+    if (leftmost) tree->leftmost = node;
+
+    // Fix red-red violations on the way back up.
+    while (node != tree->root && node->parent->red) {
+        RbNode *p = node->parent;
+        RbNode *g = p->parent;
+
+        if (p == g->left) {
+            RbNode *uncle = g->right;
+            if (uncle && uncle->red) {
+                p->red = 0;
+                uncle->red = 0;
+                g->red = 1;
+                node = g;
+            } else {
+                if (node == p->right) {
+                    node = p;
+                    rotate_left(tree, node);
+                    p = node->parent;
+                }
+                p->red = 0;
+                g->red = 1;
+                rotate_right(tree, g);
+            }
+        } else {
+            RbNode *uncle = g->left;
+            if (uncle && uncle->red) {
+                p->red = 0;
+                uncle->red = 0;
+                g->red = 1;
+                node = g;
+            } else {
+                if (node == p->left) {
+                    node = p;
+                    rotate_right(tree, node);
+                    p = node->parent;
+                }
+                p->red = 0;
+                g->red = 1;
+                rotate_left(tree, g);
+            }
+        }
+    }
+    tree->root->red = 0;
+}
+
+/**************************************************
+Method Name: transplant
+Returns: void
+Input: RbTree *tree, RbNode *u, RbNode *v
+Precondition: u is in the tree, v may be NULL
+Task: Replaces the subtree rooted at u with the subtree rooted at v.
+ **************************************************/
+static void transplant(RbTree *tree, RbNode *u, RbNode *v) {
+    if (!u->parent) tree->root = v;
+    else if (u == u->parent->left) u->parent->left = v;
+    else u->parent->right = v;
+    if (v) v->parent = u->parent;
+}
+
+/**************************************************
+Method Name: rb_erase
+Returns: void
+Input: RbTree *tree, RbNode *node
+Precondition: node is currently in tree
+Task: Removes node and rebalances the tree. Updates the cached leftmost node.
+ **************************************************/
+void rb_erase(RbTree *tree, RbNode *node) {
+    RbNode *child;
+    RbNode *parent;
+    int removedRed;
+
+    if (tree->leftmost == node) tree->leftmost = rb_next(node);
+
+    if (!node->left) {
+        child = node->right;
+        parent = node->parent;
+        removedRed = node->red;
+        transplant(tree, node, child);
+    } else if (!node->right) {
+        child = node->left;
+        parent = node->parent;
+        removedRed = node->red;
+        transplant(tree, node, child);
+    } else {
+        // Two children: splice out the successor and put it in node's place.
+        RbNode *succ = node->right;
+        while (succ->left) succ = succ->left;
+
+        removedRed = succ->red;
+        child = succ->right;
+        if (succ->parent == node) {
+            parent = succ;
+        } else {
+            parent = succ->parent;
+            transplant(tree, succ, succ->right);
+            succ->right = node->right;
+            succ->right->parent = succ;
+        }
+        transplant(tree, node, succ);
+        succ->left = node->left;
+        succ->left->parent = succ;
+        succ->red = node->red;
+    }
+
+    if (removedRed) return;
+
+    // A black node was removed, so restore equal black heights.
+    while (child != tree->root && (!child || !child->red)) {
+        if (child == parent->left) {
+            RbNode *sib = parent->right;
+            if (sib->red) {
+                sib->red = 0;
+                parent->red = 1;
+                rotate_left(tree, parent);
+                sib = parent->right;
+            }
+            if ((!sib->left || !sib->left->red) && (!sib->right || !sib->right->red)) {
+                sib->red = 1;
+                child = parent;
+                parent = child->parent;
+            } else {
+                if (!sib->right || !sib->right->red) {
+                    sib->left->red = 0;
+                    sib->red = 1;
+                    rotate_right(tree, sib);
+                    sib = parent->right;
+                }
+                sib->red = parent->red;
+                parent->red = 0;
+                sib->right->red = 0;
+                rotate_left(tree, parent);
+                child = tree->root;
+            }
+        } else {
+            RbNode *sib = parent->left;
+            if (sib->red) {
+                sib->red = 0;
+                parent->red = 1;
+                rotate_right(tree, parent);
+                sib = parent->left;
+            }
+            if ((!sib->left || !sib->left->red) && (!sib->right || !sib->right->red)) {
+                sib->red = 1;
+                child = parent;
+                parent = child->parent;
+            } else {
+                if (!sib->left || !sib->left->red) {
+                    sib->right->red = 0;
+                    sib->red = 1;
+                    rotate_left(tree, sib);
+                    sib = parent->left;
+                }
+                sib->red = parent->red;
+                parent->red = 0;
+                sib->left->red = 0;
+                rotate_right(tree, parent);
+                child = tree->root;
+            }
+        }
+    }
+    if (child) child->red = 0;
+}
+
+/**************************************************
+Method Name: rb_first
+Returns: RbNode *
+Input: const RbTree *tree
+Precondition: tree is initialized
+Task: Returns the node with the smallest key, or NULL if the tree is empty.
+ **************************************************/
+RbNode *rb_first(const RbTree *tree) {
+    return tree->leftmost;
+}
+
+/**************************************************
+Method Name: rb_next
+Returns: RbNode *
+Input: const RbNode *node
+Precondition: node is in a tree
+Task: Returns the in-order successor of node, or NULL if node is the last one.
+ **************************************************/
+RbNode *rb_next(const RbNode *node) {
+    if (node->right) {
+        node = node->right;
+        while (node->left) node = node->left;
+        return (RbNode *)node;
+    }
+    while (node->parent && node == node->parent->right) node = node->parent;
+    return node->parent;
+}
@@ -0,0 +1,17 @@
+// File: realtime.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include <stdio.h>
+
+void rt_jitter_start(long periodNs);
+void rt_jitter_record(void);
+void rt_jitter_report(FILE *out);
+void rt_jitter_stats(long *tickCount, long long *maxNs, long long *sumNs);
+int rt_harden(void);
+void rt_isolate_worker(void);
+
+#endif
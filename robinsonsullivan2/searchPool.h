@@ -0,0 +1,22 @@
+// File: searchPool.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef SEARCH_POOL_H
+#define SEARCH_POOL_H
+
+#include <stdint.h>
+
+#define POOL_MAX_THREADS 256
+
+// Searches [from, from + count) on pool thread `thread` and returns the largest prime found, or 0.
+typedef uint64_t (*RangeSearch)(int thread, uint64_t from, uint64_t count, void *arg);
+
+int pool_start(int threads, uint64_t start, uint64_t rangeSize, RangeSearch search, void *arg);
+void pool_park(void);
+void pool_resume(void);
+uint64_t pool_highest(void);
+uint64_t pool_tested(void);
+uint64_t pool_resume_point(void);
+
+#endif
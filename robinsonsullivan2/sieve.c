@@ -0,0 +1,258 @@
+// File: sieve.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "sieve.h"
+#include "primeTables.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DEFAULT_SEGMENT_BYTES 32768
+#define PATTERN_WORDS 256 // Minimum words in one pattern repeat
+
+/**************************************************
+Method Name: isqrt_u64
+Returns: uint64_t
+Input: uint64_t n
+Precondition: N/A
+Task: Returns floor(sqrt(n)) without floating point rounding errors.
+ **************************************************/
+static uint64_t isqrt_u64(uint64_t n) {
+    uint64_t r = 0;
+    for (uint64_t bit = 1ULL << 62; bit; bit >>= 2) {
+        if (n >= r + bit) {
+            n -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+    }
+    return r;
+}
+
+/**************************************************
+Method Name: first_offset
+Returns: uint64_t
+Input: uint64_t p, uint64_t low
+Precondition: p is an odd prime, low is odd
+Task: Returns the bit index, relative to low, of the first odd multiple of
+  p that is at least max(p * p, low). Smaller multiples were already
+  crossed off by smaller primes.
+ **************************************************/
+static uint64_t first_offset(uint64_t p, uint64_t low) {
+    uint64_t m = p * p;
+    if (m < low) {
+        uint64_t r = low % p;
+        m = r ? low + (p - r) : low;
+        if ((m & 1) == 0) m += p;
+    }
+    return (m - low) / 2;
+}
+
+/**************************************************
+Method Name: build_base
+Returns: int
+Input: Sieve *s
+Precondition: s->limit and s->low are set
+Task: Computes the odd base primes up to sqrt(s->limit) with a plain
+  sieve and the first multiple of each at or after s->low. Returns 0 on
+  success, -1 if memory could not be allocated.
+ **************************************************/
+static int build_base(Sieve *s) {
+    uint64_t root = isqrt_u64(s->limit) + 1;
+    // pi(x) < 1.26 x / ln x, so x / 4 is plenty for the roots used here.
+    size_t cap = root / 4 + 16;
+    unsigned char *composite = calloc(root + 1, 1);
+    uint32_t *primes = realloc(s->primes, cap * sizeof(uint32_t));
+    if (primes) s->primes = primes;
+    uint64_t *next = realloc(s->next, cap * sizeof(uint64_t));
+    if (next) s->next = next;
+    if (!composite || !primes || !next) {
+        free(composite);
+        return -1;
+    }
+
+    s->nPrimes = 0;
+    s->firstLarge = 0;
+    for (uint64_t p = 3; p <= root; p += 2) {
+        if (composite[p]) continue;
+        for (uint64_t m = p * p; m <= root; m += 2 * p) composite[m] = 1;
+        s->primes[s->nPrimes] = (uint32_t)p;
+        s->next[s->nPrimes] = first_offset(p, s->low);
+        s->nPrimes++;
+        if (p < 64) s->firstLarge = s->nPrimes;
+    }
+    free(composite);
+    return 0;
+}
+
+/**************************************************
+Method Name: build_patterns
+Returns: int
+Input: Sieve *s
+Precondition: N/A
+Task: Builds the repeating mark pattern of every odd prime below 64.
+  Returns 0 on success, -1 if memory could not be allocated.
+ **************************************************/
+static int build_patterns(Sieve *s) {
+    size_t total = 0;
+    for (int i = 0; i < PRESIEVE_PRIMES; i++) {
+        uint32_t p = presievePrimeTable[i][0];
+        s->patterns[i].p = p;
+        s->patterns[i].inverse64 = presievePrimeTable[i][1];
+        s->patterns[i].length = (PATTERN_WORDS + p - 1) / p * p;
+        total += s->patterns[i].length + p;
+    }
+
+    s->patternWords = calloc(total, sizeof(uint64_t));
+    if (!s->patternWords) return -1;
+    uint64_t *words = s->patternWords;
+    for (int i = 0; i < PRESIEVE_PRIMES; i++) {
+        SievePattern *pattern = &s->patterns[i];
+        size_t bits = (pattern->length + pattern->p) * 64;
+        pattern->words = words;
+        for (size_t j = 0; j < bits; j += pattern->p) words[j >> 6] |= 1ULL << (j & 63);
+        words += pattern->length + pattern->p;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: presieve
+Returns: void
+Input: Sieve *s
+Precondition: The segment bitset is cleared
+Task: ORs each small prime's pattern over the segment. Bit i of the
+  segment is low + 2i, which p divides for i = i0 (mod p); pattern word k
+  has its marks at those positions when 64k = -i0 (mod p).
+ **************************************************/
+static void presieve(Sieve *s) {
+    uint64_t nbits = (uint64_t)s->words * 64;
+    for (int i = 0; i < PRESIEVE_PRIMES; i++) {
+        const SievePattern *pattern = &s->patterns[i];
+        uint64_t p = pattern->p;
+        uint64_t i0 = (p - s->low % p) % p * ((p + 1) / 2) % p;
+        uint64_t k = (p - i0) % p * pattern->inverse64 % p;
+        for (size_t w = 0; w < s->words; w += pattern->length) {
+            size_t n = s->words - w < pattern->length ? s->words - w : pattern->length;
+            s->kernels->or_words(s->bits + w, pattern->words + k, n);
+        }
+        // The pattern also marks p itself, which is prime.
+        if (p >= s->low && (p - s->low) / 2 < nbits) {
+            uint64_t j = (p - s->low) / 2;
+            s->bits[j >> 6] &= ~(1ULL << (j & 63));
+        }
+    }
+}
+
+/**************************************************
+Method Name: sieve_init
+Returns: int
+Input: Sieve *s, uint64_t start, uint64_t limit, size_t segmentBytes
+Precondition: 3 <= start < limit
+Task: Sets up a sieve whose first segment begins at start, using the
+  fastest kernels the CPU supports (s->kernels). The base prime
+  table is computed once, up to sqrt(limit), and only rebuilt (doubling
+  the limit) if the search runs past it. segmentBytes 0 sizes segments to
+  the L1 data cache (32 KB if it cannot be read). Returns 0 on success,
+  -1 if memory could not be allocated.
+ **************************************************/
+int sieve_init(Sieve *s, uint64_t start, uint64_t limit, size_t segmentBytes) {
+    memset(s, 0, sizeof(*s));
+
+    if (segmentBytes == 0) {
+        long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+        segmentBytes = l1 > 0 ? (size_t)l1 : DEFAULT_SEGMENT_BYTES;
+    }
+    s->words = segmentBytes / sizeof(uint64_t);
+    if (s->words == 0) s->words = 1;
+    s->low = start | 1;
+    s->limit = limit;
+
+    s->kernels = kernels_best();
+    s->bits = malloc(s->words * sizeof(uint64_t));
+    if (!s->bits || build_patterns(s) < 0 || build_base(s) < 0) {
+        sieve_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: sieve_seek
+Returns: void
+Input: Sieve *s, uint64_t start
+Precondition: sieve_init() succeeded, start >= 3
+Task: Moves the next segment to start (rounded up to odd), for example to
+  a range taken from another thread, reusing the base prime table.
+ **************************************************/
+void sieve_seek(Sieve *s, uint64_t start) {
+    s->low = start | 1;
+    for (size_t i = 0; i < s->nPrimes; i++) s->next[i] = first_offset(s->primes[i], s->low);
+}
+
+/**************************************************
+Method Name: sieve_segment
+Returns: uint64_t
+Input: Sieve *s, uint64_t *largest
+Precondition: sieve_init() succeeded
+Task: Sieves the current segment, adds its primes to s->found, stores
+  its largest prime in *largest (left unchanged if the segment has none)
+  and moves on to the next segment. Returns how many integers the
+  segment covered, or 0 if the base primes had to be extended and
+  memory ran out.
+ **************************************************/
+uint64_t sieve_segment(Sieve *s, uint64_t *largest) {
+    uint64_t nbits = (uint64_t)s->words * 64;
+    uint64_t *bits = s->bits;
+
+    uint64_t end = s->low + 2 * nbits;
+    if (end > s->limit) {
+        while (s->limit < end && s->limit <= UINT64_MAX / 2) s->limit *= 2;
+        if (s->limit < end) s->limit = UINT64_MAX;
+        if (build_base(s) < 0) return 0;
+    }
+    memset(bits, 0, s->words * sizeof(uint64_t));
+    presieve(s);
+
+    for (size_t i = s->firstLarge; i < s->nPrimes; i++) {
+        uint64_t p = s->primes[i];
+        uint64_t j = s->next[i];
+        for (; j < nbits; j += p) bits[j >> 6] |= 1ULL << (j & 63);
+        s->next[i] = j - nbits;
+    }
+
+    s->found += nbits - s->kernels->popcount(bits, s->words);
+
+    // The largest prime is the highest clear bit.
+    for (size_t w = s->words; w-- > 0;) {
+        uint64_t clear = ~bits[w];
+        if (clear) {
+            *largest = s->low + 2 * (w * 64 + 63 - __builtin_clzll(clear));
+            break;
+        }
+    }
+
+    s->low += 2 * nbits;
+    return 2 * nbits;
+}
+
+/**************************************************
+Method Name: sieve_free
+Returns: void
+Input: Sieve *s
+Precondition: N/A
+Task: Releases the segment, pattern and base prime tables.
+ **************************************************/
+void sieve_free(Sieve *s) {
+    free(s->bits);
+    free(s->patternWords);
+    s->patternWords = NULL;
+    free(s->primes);
+    free(s->next);
+    s->bits = NULL;
+    s->primes = NULL;
+    s->next = NULL;
+    s->nPrimes = 0;
+}
@@ -0,0 +1,48 @@
+// File: sieve.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef SIEVE_H
+#define SIEVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "primeKernels.h"
+
+#define PRESIEVE_PRIMES 17 // The odd primes below 64 are marked by OR-ing repeating patterns
+
+// Marks of one small prime p: bit j is set when j is a multiple of p. One
+// repeat is a multiple of p words long, and p extra words follow so a
+// repeat can start at any of the first p words.
+typedef struct {
+    uint32_t p;
+    uint32_t inverse64; // 64^-1 mod p, finds the word whose marks line up with a segment
+    size_t length;
+    uint64_t *words;
+} SievePattern;
+
+// Segmented sieve of Eratosthenes over odd numbers. Each segment is a
+// bitset sized to the L1 data cache; bit i stands for low + 2i and is set
+// once that number is known to be composite. Primes below 64 are copied in
+// from patterns with vector ORs, larger ones are crossed off one by one.
+typedef struct {
+    uint64_t low;       // Odd number represented by bit 0 of the current segment
+    uint64_t limit;     // The base primes rule out every composite below limit
+    size_t words;       // Segment length in 64-bit words
+    uint64_t *bits;
+    uint32_t *primes;   // Odd base primes up to sqrt(limit)
+    uint64_t *next;     // Bit index of each base prime's next odd multiple, relative to low
+    size_t nPrimes;
+    size_t firstLarge;  // Index of the first base prime above the pre-sieved ones
+    SievePattern patterns[PRESIEVE_PRIMES];
+    uint64_t *patternWords;
+    const PrimeKernels *kernels; // SIMD or scalar inner loops, the best the CPU supports unless changed
+    uint64_t found;     // Primes in the segments sieved so far
+} Sieve;
+
+int sieve_init(Sieve *s, uint64_t start, uint64_t limit, size_t segmentBytes);
+void sieve_seek(Sieve *s, uint64_t start);
+uint64_t sieve_segment(Sieve *s, uint64_t *largest);
+void sieve_free(Sieve *s);
+
+#endif
@@ -4,39 +4,122 @@
 
 #include "timer.h"
 #include "srtfScheduler.h"
+#include "fairShare.h"
+#include "eventLog.h"
+#include "trace.h"
+#include "realtime.h"
+#include "replay.h"
+#include "sweep.h"
+#include "progress.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <signal.h>
 #include <sys/types.h>
+#include <sys/time.h>
 
 #define MAX_PROCS 256
+#define MAX_CLASSES 64
+#define MAX_BURSTS 16
+#define HANG_TICKS 3 // Running ticks without a heartbeat before a worker is reported as hung
 
 typedef struct {
     int procNum;        // Logical process number from input file
     int arrival;        // Arrival time (tick) when process becomes eligible
+    int bursts[MAX_BURSTS]; // Alternating CPU and I/O bursts from the input file (CPU first and last)
+    int nBursts;        // Number of entries in bursts[] (always odd)
+    int phase;          // Index of the current burst in bursts[]
+    int inIO;           // 1 while the process is blocked in an I/O burst
+    int ioUntil;        // Tick at which the current I/O burst completes
+    int burst;          // True length of the current CPU burst
     int remaining;      // Remaining burst time (ticks) left to execute
     pid_t pid;          // OS PID of spawned child process (0 means not spawned yet)
+    int spawned;        // 1 once the process has been started (a child exists unless simulating)
     int finished;       // 1 if process completed, else 0
+    int nice;           // Optional 4th input column, weights the fair share policy
+    int finishTime;     // Tick the process finished
+    FairEntity fair;    // Fair share state (vruntime, weight, CPU share)
+    int jobClass;       // Optional 5th input column, groups jobs for burst prediction
+    int predicted;      // 1 once the first burst estimate has been made at arrival
+    double prediction;  // Estimate made when the current CPU burst started
+    double estimate;    // Current burst estimate, raised if the burst outlives it
+    int used;           // Ticks of CPU used in the current burst
+    int tauSeen;        // 1 once the process has finished a CPU burst of its own
+    double tau;         // Exponential average of this process's finished CPU bursts
+    int predBursts;     // CPU bursts predicted so far
+    double predSum;     // Sum of predictions over finished bursts
+    double absErrSum;   // Sum of absolute prediction errors over finished bursts
+    double relErrSum;   // Sum of relative prediction errors over finished bursts
+    uint64_t lastTested;    // Progress record: numbers tested at the last running tick
+    uint64_t lastHeartbeat; // Progress record: heartbeat at the last running tick
+    int stalledTicks;       // Running ticks in a row without a heartbeat
 } Process;
 
-static Process procs[MAX_PROCS];
-static int nProcs = 0;
+// Scheduling policy options: SRTF by default, fair share with fairShare, or SRTF on predicted bursts with alpha >= 0.
+typedef struct {
+    int fairShare;      // 1 selects the fair share policy instead of SRTF
+    int minGranularity; // Ticks a picked process runs before fair share may preempt it
+    double alpha;       // Exponential averaging weight; >= 0 hides bursts from the policy
+    double initialTau;  // Burst estimate for a class with no history yet
+} Policy;
+
+// State of one scheduler run. The timer and -s drive a single instance (live),
+// while a sweep runs one instance per configuration x trace on worker threads.
+typedef struct {
+    Policy policy;
+    Process *procs;
+    int nProcs;
+    int cap;                 // Entries available in procs[]
+    int currentTime;         // Scheduler clock (ticks)
+    int running;             // Index of currently running process in procs[], -1 means none
+    int completed;           // Count of finished processes
+    volatile sig_atomic_t allDone; // Set by the last tick, main prints the reports and exits
+    FairQueue fairQueue;
+    double classTau[MAX_CLASSES]; // Exponential average of finished bursts per class
+    int classSeen[MAX_CLASSES];   // 1 once a job of the class has finished
+    int quiet;               // Sweep runs log no events
+    int dispatches;          // Times the CPU went to a different process
+} Scheduler;
+
+static Process liveProcs[MAX_PROCS];
+static Scheduler live;
+static int simulate = 0;     // 1 runs the ticks on a virtual clock without children or signals
+static int workerSieve = 0;  // --sieve has the children search with a segmented sieve (./child -s)
+static const char *workerThreads = NULL; // --worker-threads N runs each child with N search threads (./child -t N)
+static int progressFd = -1;  // Shared progress page the children publish to (./child -m fd:slot)
+static int showProgress = 0; // --progress logs the running child's rate every tick
+static const char *checkpointDir = NULL; // --checkpoint dir has children keep checkpoints there and resume from them (./child -c dir)
+static const char *wideBits = NULL; // --wide BITS has children search from 2^BITS with 128-bit arithmetic (./child -w BITS)
+static const char *workKind = NULL; // --kind KIND[:size] has children run a memory, cache or I/O bound workload, or a mix (./child --kind KIND)
 
-static int currentTime = 0;    // Global scheduler clock (ticks)
-static int running = -1;       // Index of currently running process in procs[], -1 means none
-static int completed = 0;      // Count of finished processes
+// --sweep grid.txt runs every grid configuration against every input file on a thread pool
+static const char *sweepPath = NULL;
+static const char *csvPath = NULL;
+static int sweepThreads = 0;
+
+/**************************************************
+Method Name: log_event
+Returns: void
+Input: Scheduler *s, int type, int procNum, int pid, int value
+Precondition: eventlog_init() has been called unless s is quiet.
+Task: Queues a scheduler event stamped with the current tick. Sweep runs share no event log, so quiet instances log nothing.
+**************************************************/
+static void log_event(Scheduler *s, int type, int procNum, int pid, int value) {
+    if (!s->quiet) eventlog_emit(type, s->currentTime, procNum, pid, value);
+}
 
 /**************************************************
 Method Name: load_input
 Returns: void
-Input: const char *path
-Precondition: path points to a readable input file with a header line and then rows: procNum arrival burst
-Task: Loads process definitions from the input file into the global procs[] array and initializes scheduler state.
+Input: Scheduler *s, const char *path
+Precondition: path points to a readable input file with a header line and then rows: procNum arrival bursts [nice [class]]
+      where bursts is one CPU burst or a comma separated list of alternating CPU and I/O bursts (e.g. 3,2,4).
+Task: Loads process definitions from the input file into s->procs[] and initializes their scheduling state.
 **************************************************/
-static void load_input(const char *path) {
+static void load_input(Scheduler *s, const char *path) {
     FILE *f = fopen(path, "r");
     if (!f) {
         perror("fopen");
@@ -57,22 +140,64 @@ static void load_input(const char *path) {
         // Skip blank lines, Windows CRLF-only lines, and comment lines.
         if (line[0] == '\n' || line[0] == '\r' || line[0] == '#') continue;
 
-        int p, a, b;
-        // Expect exactly three integers: process number, arrival time, burst time.
-        if (sscanf(line, "%d %d %d", &p, &a, &b) == 3) {
-            if (nProcs >= MAX_PROCS) {
+        int p, a, nice = 0, cls = 0, used = 0;
+        char burstList[128];
+        // Expect process number, arrival time and bursts. Nice and class are optional.
+        if (sscanf(line, "%d %d %127s %n", &p, &a, burstList, &used) >= 3) {
+            sscanf(line + used, "%d %d", &nice, &cls);
+            if (cls < 0 || cls >= MAX_CLASSES) {
+                fprintf(stderr, "Job class must be between 0 and %d\n", MAX_CLASSES - 1);
+                fclose(f);
+                exit(1);
+            }
+            if (s->nProcs >= s->cap) {
                 fprintf(stderr, "Too many processes (max %d)\n", MAX_PROCS);
                 fclose(f);
                 exit(1);
             }
 
+            // Split the burst list into alternating CPU and I/O bursts.
+            int nb = 0;
+            for (char *tok = strtok(burstList, ","); tok; tok = strtok(NULL, ",")) {
+                if (nb >= MAX_BURSTS) {
+                    fprintf(stderr, "Too many bursts for process %d (max %d)\n", p, MAX_BURSTS);
+                    fclose(f);
+                    exit(1);
+                }
+                s->procs[s->nProcs].bursts[nb++] = atoi(tok);
+            }
+            if (nb % 2 == 0) {
+                fprintf(stderr, "Process %d must start and end with a CPU burst\n", p);
+                fclose(f);
+                exit(1);
+            }
+
             // Initialize per-process scheduling fields.
-            procs[nProcs].procNum = p;
-            procs[nProcs].arrival = a;
-            procs[nProcs].remaining = b; // remaining time starts as full burst time
-            procs[nProcs].pid = 0;       // not spawned yet
-            procs[nProcs].finished = 0;  // not completed
-            nProcs++;
+            s->procs[s->nProcs].procNum = p;
+            s->procs[s->nProcs].arrival = a;
+            s->procs[s->nProcs].nBursts = nb;
+            s->procs[s->nProcs].phase = 0;
+            s->procs[s->nProcs].inIO = 0;
+            s->procs[s->nProcs].burst = s->procs[s->nProcs].bursts[0];
+            s->procs[s->nProcs].remaining = s->procs[s->nProcs].burst; // remaining time starts as the first CPU burst
+            s->procs[s->nProcs].pid = 0;       // not spawned yet
+            s->procs[s->nProcs].spawned = 0;
+            s->procs[s->nProcs].finished = 0;  // not completed
+            s->procs[s->nProcs].nice = nice;
+            s->procs[s->nProcs].finishTime = 0;
+            fair_entity_init(&s->procs[s->nProcs].fair, s->nProcs, nice);
+            s->procs[s->nProcs].jobClass = cls;
+            s->procs[s->nProcs].predicted = 0;
+            s->procs[s->nProcs].used = 0;
+            s->procs[s->nProcs].tauSeen = 0;
+            s->procs[s->nProcs].predBursts = 0;
+            s->procs[s->nProcs].predSum = 0.0;
+            s->procs[s->nProcs].absErrSum = 0.0;
+            s->procs[s->nProcs].relErrSum = 0.0;
+            s->procs[s->nProcs].lastTested = 0;
+            s->procs[s->nProcs].lastHeartbeat = 0;
+            s->procs[s->nProcs].stalledTicks = 0;
+            s->nProcs++;
         }
         // If a line doesn't match the expected format, it is silently ignored.
         // (That matches the current behavior. If you want strict parsing, change it.)
@@ -80,68 +205,310 @@ static void load_input(const char *path) {
 
     fclose(f);
 
-    if (nProcs == 0) {
+    if (s->nProcs == 0) {
         fprintf(stderr, "No processes loaded (check input format)\n");
         exit(1);
     }
 }
 
+/**************************************************
+Method Name: policy_remaining
+Returns: double
+Input: Scheduler *s, int idx
+Precondition: idx is a valid index into procs[].
+Task: Returns the remaining time the SRTF policy sees for procs[idx]: the true remaining time, or in prediction mode the estimate minus the time already used.
+**************************************************/
+static double policy_remaining(Scheduler *s, int idx) {
+    if (s->policy.alpha < 0) return s->procs[idx].remaining;
+    return s->procs[idx].estimate - s->procs[idx].used;
+}
+
+/**************************************************
+Method Name: srtf_before
+Returns: int
+Input: Scheduler *s, int i, double remI, int j, double remJ
+Precondition: i and j are valid indexes into procs[] with remaining times remI and remJ.
+Task: Returns 1 if process i should run before process j under SRTF. Ties go to the earlier arrival, then the smaller procNum.
+**************************************************/
+static int srtf_before(Scheduler *s, int i, double remI, int j, double remJ) {
+    // Primary SRTF rule: smallest remaining time wins.
+    if (remI != remJ) return remI < remJ;
+
+    // Tie-breakers to keep behavior deterministic.
+    if (s->procs[i].arrival != s->procs[j].arrival) return s->procs[i].arrival < s->procs[j].arrival;
+    return s->procs[i].procNum < s->procs[j].procNum;
+}
+
 /**************************************************
 Method Name: choose_best_ready
 Returns: int
-Input: void
+Input: Scheduler *s
 Precondition: procs[] and nProcs are initialized, currentTime reflects the scheduler tick.
 Task: Selects the index of the ready process with the smallest remaining time (SRTF). Break ties by earlier arrival, then smaller procNum.
 **************************************************/
-static int choose_best_ready(void) {
+static int choose_best_ready(Scheduler *s) {
     int best = -1;
 
-    for (int i = 0; i < nProcs; i++) {
-        // Ignore completed processes.
-        if (procs[i].finished) continue;
+    for (int i = 0; i < s->nProcs; i++) {
+        // Ignore completed processes and processes blocked in I/O.
+        if (s->procs[i].finished || s->procs[i].inIO) continue;
 
         // Process is not ready until its arrival time.
-        if (procs[i].arrival > currentTime) continue;
+        if (s->procs[i].arrival > s->currentTime) continue;
 
-        // First eligible process becomes the baseline.
-        if (best == -1) {
+        // First eligible process becomes the baseline, after that the SRTF order decides.
+        if (best == -1 || srtf_before(s, i, policy_remaining(s, i), best, policy_remaining(s, best))) {
             best = i;
-            continue;
         }
+    }
 
-        // Primary SRTF rule: smallest remaining time wins.
-        if (procs[i].remaining < procs[best].remaining) {
-            best = i;
-            continue;
+    return best; // -1 means no ready process exists at this time
+}
+
+/**************************************************
+Method Name: start_prediction
+Returns: void
+Input: Scheduler *s, int idx
+Precondition: Prediction mode is on and procs[idx] is starting a CPU burst.
+Task: Estimates the new CPU burst from the process's own past bursts, or from its class history (or the initial guess) if it has none yet.
+**************************************************/
+static void start_prediction(Scheduler *s, int idx) {
+    int c = s->procs[idx].jobClass;
+
+    if (s->procs[idx].tauSeen) s->procs[idx].prediction = s->procs[idx].tau;
+    else s->procs[idx].prediction = s->classSeen[c] ? s->classTau[c] : s->policy.initialTau;
+
+    s->procs[idx].estimate = s->procs[idx].prediction;
+    s->procs[idx].used = 0;
+}
+
+/**************************************************
+Method Name: predict_arrivals
+Returns: void
+Input: Scheduler *s
+Precondition: Prediction mode is on and currentTime reflects the scheduler tick.
+Task: Gives each newly arrived process an estimate for its first CPU burst.
+**************************************************/
+static void predict_arrivals(Scheduler *s) {
+    for (int i = 0; i < s->nProcs; i++) {
+        if (s->procs[i].predicted || s->procs[i].arrival > s->currentTime) continue;
+
+        start_prediction(s, i);
+        s->procs[i].predicted = 1;
+    }
+}
+
+/**************************************************
+Method Name: update_prediction
+Returns: void
+Input: Scheduler *s, int idx
+Precondition: Prediction mode is on and procs[idx] was charged one more tick.
+Task: If the burst has outlived its estimate, extends the estimate by one more typical burst. When the CPU burst ends, records the prediction error and folds the true burst into the process and class averages: tau = alpha * burst + (1 - alpha) * tau.
+**************************************************/
+static void update_prediction(Scheduler *s, int idx) {
+    Process *pr = &s->procs[idx];
+    int c = pr->jobClass;
+    double tau = s->classSeen[c] ? s->classTau[c] : s->policy.initialTau;
+    if (pr->tauSeen) tau = pr->tau;
+
+    if (pr->remaining > 0) {
+        if (pr->used >= pr->estimate) {
+            pr->estimate = pr->used + tau;
         }
+        return;
+    }
 
-        // Tie-breakers to keep behavior deterministic.
-        if (procs[i].remaining == procs[best].remaining) {
-            // Earlier arrival time wins.
-            if (procs[i].arrival < procs[best].arrival) {
-                best = i;
-                continue;
-            }
-            // If arrival also ties, smaller process number wins.
-            if (procs[i].arrival == procs[best].arrival &&
-                procs[i].procNum < procs[best].procNum) {
-                best = i;
-                continue;
+    double err = pr->prediction - pr->burst;
+    if (err < 0) err = -err;
+    pr->predBursts++;
+    pr->predSum += pr->prediction;
+    pr->absErrSum += err;
+    if (pr->burst > 0) pr->relErrSum += err / pr->burst;
+
+    pr->tau = s->policy.alpha * pr->burst + (1.0 - s->policy.alpha) * (pr->tauSeen ? pr->tau : pr->prediction);
+    pr->tauSeen = 1;
+    s->classTau[c] = s->policy.alpha * pr->burst + (1.0 - s->policy.alpha) * (s->classSeen[c] ? s->classTau[c] : s->policy.initialTau);
+    s->classSeen[c] = 1;
+}
+
+/**************************************************
+Method Name: oracle_turnaround
+Returns: double
+Input: Scheduler *s
+Precondition: procs[] has been loaded.
+Task: Replays the input on a virtual clock with SRTF using the true bursts, using the same tick rules as scheduler_tick() (including I/O bursts), and returns the average turnaround time.
+**************************************************/
+static double oracle_turnaround(Scheduler *s) {
+    int rem[MAX_PROCS];
+    int phase[MAX_PROCS];
+    int ioUntil[MAX_PROCS];
+    int done[MAX_PROCS];
+    int finishedCount = 0, run = -1, t = 0;
+    long total = 0;
+
+    for (int i = 0; i < s->nProcs; i++) {
+        rem[i] = s->procs[i].bursts[0];
+        phase[i] = 0;
+        ioUntil[i] = -1;
+        done[i] = 0;
+    }
+
+    while (finishedCount < s->nProcs) {
+        t++;
+        if (run != -1 && --rem[run] <= 0) {
+            if (phase[run] == s->procs[run].nBursts - 1) {
+                done[run] = 1;
+                total += t - s->procs[run].arrival;
+                finishedCount++;
+            } else {
+                phase[run]++;
+                ioUntil[run] = t + s->procs[run].bursts[phase[run]];
             }
         }
+
+        for (int i = 0; i < s->nProcs; i++) {
+            if (ioUntil[i] == -1 || ioUntil[i] > t) continue;
+            ioUntil[i] = -1;
+            phase[i]++;
+            rem[i] = s->procs[i].bursts[phase[i]];
+        }
+
+        run = -1;
+        for (int i = 0; i < s->nProcs; i++) {
+            if (done[i] || ioUntil[i] != -1 || s->procs[i].arrival > t) continue;
+            if (run == -1 || srtf_before(s, i, rem[i], run, rem[run])) run = i;
+        }
     }
 
-    return best; // -1 means no ready process exists at this time
+    return (double)total / s->nProcs;
+}
+
+/**************************************************
+Method Name: print_prediction_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished in prediction mode.
+Task: Prints each process's average predicted and true CPU burst, the mean prediction error, and the average turnaround next to the oracle SRTF that knew the true bursts.
+**************************************************/
+static void print_prediction_report(Scheduler *s) {
+    double absErr = 0.0, relErr = 0.0;
+    int bursts = 0;
+    long turnaround = 0;
+
+    printf("Burst prediction (alpha=%.2f, initial=%.1f):\n", s->policy.alpha, s->policy.initialTau);
+    for (int i = 0; i < s->nProcs; i++) {
+        Process *pr = &s->procs[i];
+        int cpuTotal = 0;
+        for (int k = 0; k < pr->nBursts; k += 2) cpuTotal += pr->bursts[k];
+
+        double predicted = pr->predBursts ? pr->predSum / pr->predBursts : 0.0;
+        double actual = pr->predBursts ? (double)cpuTotal / pr->predBursts : 0.0;
+        printf("p=%d class=%d bursts=%d predicted=%.1f actual=%.1f error=%+.1f\n",
+               pr->procNum, pr->jobClass, pr->predBursts, predicted, actual, predicted - actual);
+        absErr += pr->absErrSum;
+        relErr += pr->relErrSum;
+        bursts += pr->predBursts;
+        turnaround += pr->finishTime - pr->arrival;
+    }
+    if (bursts == 0) bursts = 1;
+
+    double avg = (double)turnaround / s->nProcs;
+    double oracle = oracle_turnaround(s);
+    printf("Mean absolute error: %.2f ticks (%.1f%%)\n", absErr / bursts, 100.0 * relErr / bursts);
+    printf("Average turnaround: %.2f predicted vs %.2f oracle SRTF (%+.1f%%)\n",
+           avg, oracle, oracle > 0 ? 100.0 * (avg - oracle) / oracle : 0.0);
+}
+
+/**************************************************
+Method Name: print_io_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished.
+Task: Compares the makespan of this run, where the CPU runs other work while jobs are in I/O, with running each job's CPU and I/O bursts back to back one job at a time, and prints the throughput of both.
+**************************************************/
+static void print_io_report(Scheduler *s) {
+    int order[MAX_PROCS];
+    int first = s->procs[0].arrival, last = 0, cpuBusy = 0;
+
+    for (int i = 0; i < s->nProcs; i++) {
+        order[i] = i;
+        if (s->procs[i].arrival < first) first = s->procs[i].arrival;
+        if (s->procs[i].finishTime > last) last = s->procs[i].finishTime;
+        for (int k = 0; k < s->procs[i].nBursts; k += 2) cpuBusy += s->procs[i].bursts[k];
+    }
+
+    // Serialized baseline: first come first served, the CPU idles during each job's I/O.
+    for (int i = 1; i < s->nProcs; i++) {
+        for (int j = i; j > 0 && s->procs[order[j]].arrival < s->procs[order[j - 1]].arrival; j--) {
+            int tmp = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = tmp;
+        }
+    }
+    int t = first;
+    for (int i = 0; i < s->nProcs; i++) {
+        Process *pr = &s->procs[order[i]];
+        if (t < pr->arrival) t = pr->arrival;
+        for (int k = 0; k < pr->nBursts; k++) t += pr->bursts[k];
+    }
+
+    int makespan = last - first;
+    int serial = t - first;
+    if (makespan <= 0) makespan = 1;
+    if (serial <= 0) serial = 1;
+    printf("I/O overlap: makespan %d vs %d serialized, throughput %.3f vs %.3f jobs/tick (%+.1f%%), CPU busy %.1f%%\n",
+           makespan, serial, (double)s->nProcs / makespan, (double)s->nProcs / serial,
+           100.0 * ((double)serial / makespan - 1.0), 100.0 * cpuBusy / makespan);
+}
+
+/**************************************************
+Method Name: choose_fair
+Returns: int
+Input: Scheduler *s
+Precondition: Fair share mode is on and this tick has been accounted with fair_account_tick().
+Task: Adds newly arrived processes to the fair run queue and returns the index of the process with the smallest virtual runtime. The running process keeps the CPU until it has run minGranularity ticks.
+**************************************************/
+static int choose_fair(Scheduler *s) {
+    for (int i = 0; i < s->nProcs; i++) {
+        if (i == s->running || s->procs[i].finished || s->procs[i].inIO || s->procs[i].fair.queued) continue;
+        if (s->procs[i].arrival > s->currentTime) continue;
+        fair_enqueue(&s->fairQueue, &s->procs[i].fair);
+    }
+
+    return fair_pick(&s->fairQueue, s->running != -1 ? &s->procs[s->running].fair : NULL);
+}
+
+/**************************************************
+Method Name: print_share_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished in fair share mode.
+Task: Prints each process's share of the CPU while it was in the system next to the share its weight entitled it to.
+**************************************************/
+static void print_share_report(Scheduler *s) {
+    printf("CPU share (fair share, min granularity %d):\n", s->policy.minGranularity);
+    for (int i = 0; i < s->nProcs; i++) {
+        int life = s->procs[i].finishTime - s->procs[i].arrival;
+        if (life <= 0) life = 1;
+        printf("p=%d nice=%d weight=%d ran=%d/%d share=%.1f%% entitled=%.1f%%\n",
+               s->procs[i].procNum, s->procs[i].nice, s->procs[i].fair.weight,
+               s->procs[i].fair.ranTicks, life,
+               100.0 * s->procs[i].fair.ranTicks / life,
+               100.0 * s->procs[i].fair.entitledTicks / life);
+    }
 }
 
 /**************************************************
 Method Name: spawn_child
 Returns: void
-Input: int idx
-Precondition: idx is a valid index into procs[], and procs[idx].pid == 0 (child not spawned yet).
-Task: Forks and execs the ./child program for the selected process, storing the spawned PID in procs[idx].pid.
+Input: Scheduler *s, int idx
+Precondition: idx is a valid index into procs[], and procs[idx].spawned == 0 (child not spawned yet).
+Task: Forks and execs the ./child program for the selected process, storing the spawned PID in procs[idx].pid. In simulated mode no child is created.
 **************************************************/
-static void spawn_child(int idx) {
+static void spawn_child(Scheduler *s, int idx) {
+    s->procs[idx].spawned = 1;
+    if (simulate) return;
+
     pid_t pid = fork();
     if (pid < 0) {
         perror("fork");
@@ -149,164 +516,747 @@ static void spawn_child(int idx) {
     }
 
     if (pid == 0) {
+        // In --rt mode keep the worker off the scheduler's CPU.
+        rt_isolate_worker();
+
         // Child process: exec the worker program.
         // Pass the process number as "-p <procNum>".
         char pstr[32];
-        snprintf(pstr, sizeof(pstr), "%d", procs[idx].procNum);
+        snprintf(pstr, sizeof(pstr), "%d", s->procs[idx].procNum);
 
-        execlp("./child", "./child", "-p", pstr, (char *)NULL);
+        // When recording or replaying, seed the worker from its process number so reruns match.
+        // (procNum + 1 because glibc treats seeds 0 and 1 the same.)
+        char seed[32];
+        snprintf(seed, sizeof(seed), "%d", s->procs[idx].procNum + 1);
+        char *args[17], progressSpec[32];
+        int n = 0;
+        args[n++] = "./child";
+        args[n++] = "-p";
+        args[n++] = pstr;
+        if (replay_active()) {
+            args[n++] = "-r";
+            args[n++] = seed;
+        }
+        if (workerSieve) args[n++] = "-s";
+        if (wideBits) {
+            args[n++] = "-w";
+            args[n++] = (char *)wideBits;
+        }
+        if (workKind) {
+            args[n++] = "--kind";
+            args[n++] = (char *)workKind;
+        }
+        if (workerThreads) {
+            args[n++] = "-t";
+            args[n++] = (char *)workerThreads;
+        }
+        if (progressFd >= 0) {
+            snprintf(progressSpec, sizeof(progressSpec), "%d:%d", progressFd, idx);
+            args[n++] = "-m";
+            args[n++] = progressSpec;
+        }
+        if (checkpointDir) {
+            args[n++] = "-c";
+            args[n++] = (char *)checkpointDir;
+        }
+        args[n] = NULL;
+        execvp("./child", args);
 
-        // If execlp returns, it failed.
-        perror("execlp");
+        // If execvp returns, it failed.
+        perror("execvp");
         _exit(1); // Use _exit in child after fork to avoid flushing parent buffers twice.
     }
 
     // Parent process: record the child's PID so we can signal it later.
-    procs[idx].pid = pid;
+    s->procs[idx].pid = pid;
+}
+
+/**************************************************
+Method Name: send_signal
+Returns: void
+Input: Scheduler *s, int idx, int sig
+Precondition: idx is a valid index into procs[] and the process has been spawned.
+Task: Sends sig to the child for procs[idx]. Does nothing in simulated mode, where no children exist.
+**************************************************/
+static void send_signal(Scheduler *s, int idx, int sig) {
+    if (simulate) return;
+    kill(s->procs[idx].pid, sig);
 }
 
 /**************************************************
 Method Name: start_or_resume
 Returns: void
-Input: int idx
+Input: Scheduler *s, int idx
 Precondition: idx is a valid index into procs[], procs[idx] is not finished, and currentTime is current scheduler tick.
-Task: Ensures the process exists (spawn if needed) and then runs it by sending SIGCONT. Prints START/CONTINUE log output.
+Task: Ensures the process exists (spawn if needed) and then runs it by sending SIGCONT. Logs a START/CONTINUE event.
 **************************************************/
-static void start_or_resume(int idx) {
-    if (procs[idx].pid == 0) {
+static void start_or_resume(Scheduler *s, int idx) {
+    if (!s->procs[idx].spawned) {
         // First time this process is chosen, create the child process.
-        spawn_child(idx);
+        spawn_child(s, idx);
 
         // Log that the process is starting for the first time.
-        printf("t=%d START p=%d pid=%d rem=%d\n",
-               currentTime, procs[idx].procNum, procs[idx].pid, procs[idx].remaining);
-        fflush(stdout);
+        log_event(s, EV_START, s->procs[idx].procNum, s->procs[idx].pid, s->procs[idx].remaining);
     } else {
         // Process already exists, so this is a resume after preemption.
-        printf("t=%d CONTINUE p=%d pid=%d rem=%d\n",
-               currentTime, procs[idx].procNum, procs[idx].pid, procs[idx].remaining);
-        fflush(stdout);
+        log_event(s, EV_CONTINUE, s->procs[idx].procNum, s->procs[idx].pid, s->procs[idx].remaining);
     }
 
     // Let the process run (or keep running) by continuing it.
-    kill(procs[idx].pid, SIGCONT);
+    send_signal(s, idx, SIGCONT);
 }
 
 /**************************************************
 Method Name: preempt
 Returns: void
-Input: int idx
+Input: Scheduler *s, int idx
 Precondition: idx is a valid index into procs[], procs[idx].pid != 0, and the process is currently running.
-Task: Stops the running process using SIGTSTP to simulate preemption and prints a PREEMPT log line.
+Task: Stops the running process using SIGTSTP to simulate preemption and logs a PREEMPT event.
 **************************************************/
-static void preempt(int idx) {
-    printf("t=%d PREEMPT p=%d pid=%d rem=%d\n",
-           currentTime, procs[idx].procNum, procs[idx].pid, procs[idx].remaining);
-    fflush(stdout);
+static void preempt(Scheduler *s, int idx) {
+    log_event(s, EV_PREEMPT, s->procs[idx].procNum, s->procs[idx].pid, s->procs[idx].remaining);
 
     // SIGTSTP requests the process to stop (like Ctrl+Z), simulating a context switch out.
-    kill(procs[idx].pid, SIGTSTP);
+    send_signal(s, idx, SIGTSTP);
 }
 
 /**************************************************
 Method Name: finish
 Returns: void
-Input: int idx
+Input: Scheduler *s, int idx
 Precondition: idx is a valid index into procs[], procs[idx].pid != 0, and procs[idx].remaining <= 0.
-Task: Terminates the child process, marks it finished in the scheduler tables, increments completion count, and prints a FINISH log line.
+Task: Terminates the child process, marks it finished in the scheduler tables, increments completion count, and logs a FINISH event.
 **************************************************/
-static void finish(int idx) {
-    printf("t=%d FINISH p=%d pid=%d\n",
-           currentTime, procs[idx].procNum, procs[idx].pid);
-    fflush(stdout);
+static void finish(Scheduler *s, int idx) {
+    log_event(s, EV_FINISH, s->procs[idx].procNum, s->procs[idx].pid, 0);
 
     // End the child process now that its burst is complete.
-    kill(procs[idx].pid, SIGTERM);
+    send_signal(s, idx, SIGTERM);
 
     // Update scheduler bookkeeping.
-    procs[idx].finished = 1;
-    completed++;
+    s->procs[idx].finished = 1;
+    s->procs[idx].finishTime = s->currentTime;
+    s->completed++;
 }
 
 /**************************************************
-Method Name: scheduler_tick
+Method Name: start_io
 Returns: void
-Input: void
-Precondition: timer_start() has been called with scheduler_tick as its callback, and procs[] has been loaded.
-Task: Advances the scheduler one tick: updates the running process remaining time, finishes it if done, selects the best ready process (SRTF), preempts if needed, and starts/resumes the chosen process.
+Input: Scheduler *s, int idx
+Precondition: idx is the running process and its current CPU burst just ended with more bursts to go.
+Task: Moves the process into its next I/O burst. The child is sent SIGUSR1 carrying the I/O length so it really blocks for that long, and the process leaves the ready queue until ioUntil.
 **************************************************/
-void scheduler_tick(void) {
+static void start_io(Scheduler *s, int idx) {
+    s->procs[idx].phase++;
+    s->procs[idx].inIO = 1;
+    s->procs[idx].ioUntil = s->currentTime + s->procs[idx].bursts[s->procs[idx].phase];
+
+    log_event(s, EV_IO, s->procs[idx].procNum, s->procs[idx].pid, s->procs[idx].bursts[s->procs[idx].phase]);
+
+    // The I/O length rides along with the signal so the child knows how long to block.
+    union sigval value;
+    value.sival_int = s->procs[idx].bursts[s->procs[idx].phase];
+    if (!simulate) sigqueue(s->procs[idx].pid, SIGUSR1, value);
+}
+
+/**************************************************
+Method Name: complete_io
+Returns: void
+Input: Scheduler *s
+Precondition: currentTime reflects the scheduler tick.
+Task: Returns every process whose I/O burst has completed to the ready queue with its next CPU burst loaded.
+**************************************************/
+static void complete_io(Scheduler *s) {
+    for (int i = 0; i < s->nProcs; i++) {
+        if (!s->procs[i].inIO || s->procs[i].ioUntil > s->currentTime) continue;
+
+        s->procs[i].inIO = 0;
+        s->procs[i].phase++;
+        s->procs[i].burst = s->procs[i].bursts[s->procs[i].phase];
+        s->procs[i].remaining = s->procs[i].burst;
+        if (s->policy.alpha >= 0) start_prediction(s, i);
+
+        log_event(s, EV_READY, s->procs[i].procNum, s->procs[i].pid, s->procs[i].remaining);
+    }
+}
+
+/**************************************************
+Method Name: check_progress
+Returns: void
+Input: Scheduler *s
+Precondition: Called at the start of a tick, while s->running is still the process that ran during the last tick.
+Task: Reads the running child's progress record without signalling it. With --progress logs how many numbers it tested in the last tick, and logs a HANG event once if its heartbeat has not moved for HANG_TICKS running ticks.
+**************************************************/
+static void check_progress(Scheduler *s) {
+    if (s->running == -1 || s->procs[s->running].finished) return;
+    const ProgressRecord *record = progress_record(s->running);
+    if (!record) return;
+
+    Process *p = &s->procs[s->running];
+    uint64_t tested = atomic_load_explicit(&record->tested, memory_order_relaxed);
+    uint64_t heartbeat = atomic_load_explicit(&record->heartbeat, memory_order_relaxed);
+    if (showProgress) log_event(s, EV_PROGRESS, p->procNum, p->pid, (int)((tested - p->lastTested) / 1000));
+    if (heartbeat == p->lastHeartbeat) {
+        if (++p->stalledTicks == HANG_TICKS) log_event(s, EV_HANG, p->procNum, p->pid, p->stalledTicks);
+    } else {
+        p->stalledTicks = 0;
+    }
+    p->lastTested = tested;
+    p->lastHeartbeat = heartbeat;
+}
+
+/**************************************************
+Method Name: advance_tick
+Returns: void
+Input: Scheduler *s
+Precondition: s->procs[] has been loaded.
+Task: Advances scheduler s one tick: updates the running process remaining time, finishes it or starts its I/O burst if done, returns processes whose I/O completed, selects the best ready process (SRTF), preempts if needed, and starts/resumes the chosen process.
+**************************************************/
+static void advance_tick(Scheduler *s) {
+    // Nothing left to schedule once main has been told to finish up.
+    if (s->allDone) return;
+
     // Advance simulated time by 1 tick (called once per second by the timer).
-    currentTime++;
+    s->currentTime++;
+
+    // Read how far the running child got in the last tick.
+    check_progress(s);
+
+    // Log arrivals so the event stream (and the trace built from it) shows when processes became ready.
+    for (int i = 0; i < s->nProcs; i++) {
+        if (s->procs[i].arrival == s->currentTime) {
+            log_event(s, EV_ARRIVE, s->procs[i].procNum, 0, s->procs[i].remaining);
+            replay_arrival(s->currentTime, s->procs[i].procNum);
+        }
+    }
+
+    // In fair share mode, charge the last tick's weighted virtual runtime and entitlement.
+    if (s->policy.fairShare) {
+        fair_account_tick(&s->fairQueue, s->running != -1 ? &s->procs[s->running].fair : NULL);
+    }
 
     // If a process is currently running, charge it one unit of CPU time.
-    if (running != -1 && !procs[running].finished) {
-        procs[running].remaining--;
+    if (s->running != -1 && !s->procs[s->running].finished) {
+        s->procs[s->running].remaining--;
+        s->procs[s->running].used++;
+        if (s->policy.alpha >= 0) update_prediction(s, s->running);
+        replay_tick(s->currentTime, s->procs[s->running].procNum, s->procs[s->running].remaining);
 
-        // If it just completed, finalize it and clear the CPU.
-        if (procs[running].remaining <= 0) {
-            finish(running);
-            running = -1;
+        // If its CPU burst just ended, finalize it (or send it to I/O) and clear the CPU.
+        if (s->procs[s->running].remaining <= 0) {
+            if (s->procs[s->running].phase == s->procs[s->running].nBursts - 1) finish(s, s->running);
+            else start_io(s, s->running);
+            s->running = -1;
         }
+    } else {
+        replay_tick(s->currentTime, -1, 0);
     }
 
-    // If everything has finished, print and exit the scheduler.
-    if (completed == nProcs) {
-        printf("Complete!\n");
-        fflush(stdout);
-        exit(0);
+    // Processes whose I/O completed rejoin the ready queue.
+    complete_io(s);
+
+    // If everything has finished, let main print the reports and exit.
+    if (s->completed == s->nProcs) {
+        log_event(s, EV_COMPLETE, -1, 0, 0);
+        s->allDone = 1;
+        return;
     }
 
-    // Pick the best ready process according to SRTF.
-    int best = choose_best_ready();
+    // In prediction mode, newly arrived processes get a burst estimate.
+    if (s->policy.alpha >= 0) predict_arrivals(s);
+
+    // Pick the best ready process according to SRTF (or fair share), timing the selection path for replay.
+    uint64_t selectStart = replay_active() ? replay_clock_ns() : 0;
+    int best = s->policy.fairShare ? choose_fair(s) : choose_best_ready(s);
+    if (replay_active()) {
+        replay_select(s->currentTime, s->running != -1 ? s->procs[s->running].procNum : -1,
+                      best != -1 ? s->procs[best].procNum : -1, replay_clock_ns() - selectStart);
+    }
     if (best == -1) {
         // No ready processes at this time, CPU stays idle.
         return;
     }
 
     // If the chosen process is already running, nothing to switch.
-    // (This prints a CONTINUE each tick for the same running process, matching current behavior.)
-    if (best == running) {
-        printf("t=%d CONTINUE p=%d pid=%d rem=%d\n",
-               currentTime,
-               procs[running].procNum,
-               procs[running].pid,
-               procs[running].remaining);
-        fflush(stdout);
+    // (This logs a CONTINUE each tick for the same running process, matching current behavior.)
+    if (best == s->running) {
+        log_event(s, EV_CONTINUE, s->procs[s->running].procNum, s->procs[s->running].pid, s->procs[s->running].remaining);
         return;
     }
 
     // If a different process should run now, stop the current one (if any).
-    if (running != -1) {
-        preempt(running);
+    if (s->running != -1) {
+        preempt(s, s->running);
     }
 
     // Context switch in the new best process.
-    running = best;
-    start_or_resume(running);
+    if (s->policy.fairShare) {
+        fair_switch(&s->fairQueue, s->running != -1 ? &s->procs[s->running].fair : NULL, &s->procs[best].fair);
+    }
+    s->running = best;
+    s->dispatches++;
+    start_or_resume(s, s->running);
+}
+
+/**************************************************
+Method Name: scheduler_tick
+Returns: void
+Input: void
+Precondition: timer_start() has been called with scheduler_tick as its callback, and the live scheduler has been loaded.
+Task: Advances the live scheduler one tick.
+**************************************************/
+void scheduler_tick(void) {
+    advance_tick(&live);
+}
+
+/**************************************************
+Method Name: trace_event
+Returns: void
+Input: const Event *ev
+Precondition: Registered with eventlog_set_sink() after trace_init().
+Task: Turns each flushed scheduler event into a state change on the trace timeline.
+**************************************************/
+static void trace_event(const Event *ev) {
+    switch (ev->type) {
+        case EV_ARRIVE:
+        case EV_READY:
+            trace_state(ev->tick, ev->procNum, TRACE_READY);
+            break;
+        case EV_START:
+        case EV_CONTINUE:
+            trace_state(ev->tick, ev->procNum, TRACE_RUNNING);
+            break;
+        case EV_PREEMPT:
+            trace_state(ev->tick, ev->procNum, TRACE_STOPPED);
+            trace_preempt(ev->tick, ev->procNum);
+            break;
+        case EV_IO:
+            trace_state(ev->tick, ev->procNum, TRACE_IO);
+            break;
+        case EV_FINISH:
+            trace_state(ev->tick, ev->procNum, TRACE_DONE);
+            break;
+        case EV_COMPLETE:
+            trace_finish(ev->tick);
+            break;
+    }
+}
+
+/**************************************************
+Method Name: print_work_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished and the children had a progress page.
+Task: With --kind, prints what each child did besides the prime search: MB streamed, pointer hops and fsync'd writes, each with its rate per second of CPU time it was given. Prints nothing for cpu children.
+**************************************************/
+static void print_work_report(Scheduler *s) {
+    int header = 0;
+    for (int i = 0; i < s->nProcs; i++) {
+        const ProgressRecord *record = progress_record(i);
+        if (!record) continue;
+        double mb = atomic_load_explicit(&record->work[PROGRESS_STREAMED], memory_order_relaxed) / 1048576.0;
+        double hops = atomic_load_explicit(&record->work[PROGRESS_HOPS], memory_order_relaxed) / 1e6;
+        double syncs = (double)atomic_load_explicit(&record->work[PROGRESS_SYNCS], memory_order_relaxed);
+        if (mb == 0 && hops == 0 && syncs == 0) continue;
+        if (!header) {
+            printf("\nOther work (--kind):\n");
+            printf("%8s %12s %10s %10s %10s %10s %10s\n", "Process", "MB streamed", "MB/s", "M hops", "M hops/s",
+                   "Syncs", "Syncs/s");
+            header = 1;
+        }
+        int cpu = 0;
+        for (int b = 0; b < s->procs[i].nBursts; b += 2) cpu += s->procs[i].bursts[b];
+        double per = cpu > 0 ? 1.0 / cpu : 0.0;
+        printf("%8d %12.0f %10.1f %10.1f %10.2f %10.0f %10.1f\n", s->procs[i].procNum, mb, mb * per, hops, hops * per,
+               syncs, syncs * per);
+    }
+}
+
+/**************************************************
+Method Name: print_progress_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished and the children had a progress page.
+Task: Prints each child's final progress record: numbers tested, primes found, highest prime and the rate per second of CPU time it was given.
+**************************************************/
+static void print_progress_report(Scheduler *s) {
+    printf("\nWorker progress:\n");
+    printf("%8s %14s %10s %22s %12s\n", "Process", "Tested", "Primes", "Highest", "k/s");
+    for (int i = 0; i < s->nProcs; i++) {
+        const ProgressRecord *record = progress_record(i);
+        if (!record) continue;
+        int cpu = 0;
+        for (int b = 0; b < s->procs[i].nBursts; b += 2) cpu += s->procs[i].bursts[b];
+        uint64_t tested = atomic_load_explicit(&record->tested, memory_order_relaxed);
+        printf("%8d %14llu %10llu %22llu %12.1f\n", s->procs[i].procNum, (unsigned long long)tested,
+               (unsigned long long)atomic_load_explicit(&record->found, memory_order_relaxed),
+               (unsigned long long)atomic_load_explicit(&record->highest, memory_order_relaxed),
+               cpu > 0 ? tested / 1000.0 / cpu : 0.0);
+    }
+    print_work_report(s);
+}
+
+/**************************************************
+Method Name: print_reports
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished and the event log has been flushed.
+Task: Prints the end of run reports for the selected policy and input.
+**************************************************/
+static void print_reports(Scheduler *s) {
+    if (s->policy.fairShare) print_share_report(s);
+    if (s->policy.alpha >= 0) print_prediction_report(s);
+    for (int i = 0; i < s->nProcs; i++) {
+        if (s->procs[i].nBursts > 1) {
+            print_io_report(s);
+            break;
+        }
+    }
+    if (!simulate) rt_jitter_report(stdout);
+    if (progressFd >= 0) print_progress_report(s);
+    if (eventlog_dropped() > 0) printf("Event log dropped %lu events (ring full)\n", eventlog_dropped());
+    fflush(stdout);
+}
+
+/**************************************************
+Method Name: policy_init
+Returns: void
+Input: Policy *policy
+Precondition: N/A
+Task: Sets the default policy: SRTF on the true bursts.
+**************************************************/
+static void policy_init(Policy *policy) {
+    policy->fairShare = 0;
+    policy->minGranularity = 1;
+    policy->alpha = -1.0;
+    policy->initialTau = 5.0;
+}
+
+/**************************************************
+Method Name: policy_option
+Returns: int
+Input: Policy *policy, int opt, const char *arg
+Precondition: opt is one of the policy options f, g, e or i.
+Task: Applies one policy option. Returns 0 if its value is out of range.
+**************************************************/
+static int policy_option(Policy *policy, int opt, const char *arg) {
+    switch (opt) {
+        case 'f':
+            policy->fairShare = 1;
+            break;
+        case 'g':
+            policy->minGranularity = atoi(arg);
+            break;
+        case 'e':
+            policy->alpha = atof(arg);
+            if (policy->alpha < 0.0 || policy->alpha > 1.0) return 0;
+            break;
+        case 'i':
+            policy->initialTau = atof(arg);
+            break;
+    }
+    return 1;
+}
+
+/**************************************************
+Method Name: policy_valid
+Returns: int
+Input: const Policy *policy
+Precondition: N/A
+Task: Returns 1 if the options combine into a usable policy (fair share and burst prediction are exclusive).
+**************************************************/
+static int policy_valid(const Policy *policy) {
+    return policy->minGranularity >= 1 && !(policy->fairShare && policy->alpha >= 0);
+}
+
+// Inputs and results of a --sweep, shared read-only by the pool threads
+typedef struct {
+    Policy *policies;
+    int nTraces;
+    Process **traceProcs;   // Each input file as loaded by load_input
+    int *traceCounts;
+    SweepResult *results;   // One slot per run, written only by that run
+} Sweep;
+
+/**************************************************
+Method Name: sweep_one
+Returns: void
+Input: int run, void *ctx
+Precondition: ctx is the Sweep and run < policies x traces.
+Task: Runs one policy over one input file on its own scheduler instance and virtual clock, then stores the run's metrics. Waiting time is the time in the system not spent on the CPU or in I/O. A run that goes past the last arrival plus every burst is stopped and reported as not finished.
+**************************************************/
+static void sweep_one(int run, void *ctx) {
+    Sweep *sw = ctx;
+    int t = run % sw->nTraces;
+    SweepResult *r = &sw->results[run];
+    int count = sw->traceCounts[t];
+
+    Scheduler *s = calloc(1, sizeof(*s));
+    Process *procs = malloc(sizeof(Process) * (size_t)count);
+    if (!s || !procs) {
+        free(s);
+        free(procs);
+        return;
+    }
+    memcpy(procs, sw->traceProcs[t], sizeof(Process) * (size_t)count);
+    s->policy = sw->policies[run / sw->nTraces];
+    s->procs = procs;
+    s->nProcs = count;
+    s->cap = count;
+    s->running = -1;
+    s->quiet = 1;
+    if (s->policy.fairShare) fair_init(&s->fairQueue, s->policy.minGranularity);
+
+    int limit = 1;
+    for (int i = 0; i < count; i++) {
+        if (procs[i].arrival > limit) limit = procs[i].arrival;
+    }
+    for (int i = 0; i < count; i++) {
+        for (int k = 0; k < procs[i].nBursts; k++) limit += procs[i].bursts[k];
+    }
+
+    while (!s->allDone && s->currentTime <= limit) advance_tick(s);
+
+    r->ok = s->allDone;
+    r->jobs = count;
+    r->makespan = s->currentTime;
+    r->dispatches = s->dispatches;
+    long turnaround = 0, wait = 0;
+    for (int i = 0; i < count; i++) {
+        int inSystem = procs[i].finishTime - procs[i].arrival;
+        int busy = 0;
+        for (int k = 0; k < procs[i].nBursts; k++) busy += procs[i].bursts[k];
+        turnaround += inSystem;
+        wait += inSystem - busy;
+        if (inSystem - busy > r->maxWait) r->maxWait = inSystem - busy;
+    }
+    r->avgTurnaround = count ? (double)turnaround / count : 0.0;
+    r->avgWait = count ? (double)wait / count : 0.0;
+
+    free(procs);
+    free(s);
+}
+
+/**************************************************
+Method Name: run_sweep
+Returns: int
+Input: char **traces, int nTraces
+Precondition: sweepPath is set.
+Task: Expands the grid, parses every configuration, loads every input file, runs all configuration x input pairs on the thread pool and writes the CSV. Returns the exit status.
+**************************************************/
+static int run_sweep(char **traces, int nTraces) {
+    char **configs;
+    int nConfigs = sweep_expand_grid(sweepPath, &configs);
+    if (nConfigs <= 0) {
+        fprintf(stderr, "No configurations in %s\n", sweepPath);
+        return 1;
+    }
+
+    Sweep sw;
+    sw.nTraces = nTraces;
+    sw.policies = malloc(sizeof(Policy) * (size_t)nConfigs);
+    sw.traceProcs = malloc(sizeof(Process *) * (size_t)nTraces);
+    sw.traceCounts = malloc(sizeof(int) * (size_t)nTraces);
+    sw.results = calloc((size_t)nConfigs * (size_t)nTraces, sizeof(SweepResult));
+    if (!sw.policies || !sw.traceProcs || !sw.traceCounts || !sw.results) return 1;
+
+    // getopt and load_input (strtok) are not thread safe, so everything is parsed up front.
+    for (int c = 0; c < nConfigs; c++) {
+        char line[1024];
+        char *args[SWEEP_MAX_ARGS + 1];
+        snprintf(line, sizeof(line), "%s", configs[c]);
+        int argc = sweep_split(line, args, SWEEP_MAX_ARGS);
+        int opt, ok = 1;
+
+        policy_init(&sw.policies[c]);
+        optind = 0;
+        while ((opt = getopt(argc, args, "fg:e:i:")) != -1) {
+            if (opt == '?' || !policy_option(&sw.policies[c], opt, optarg)) ok = 0;
+        }
+        if (!ok || optind != argc || !policy_valid(&sw.policies[c])) {
+            fprintf(stderr, "Bad configuration in %s: %s\n", sweepPath, configs[c]);
+            return 1;
+        }
+    }
+    for (int t = 0; t < nTraces; t++) {
+        live.nProcs = 0;
+        load_input(&live, traces[t]);
+        sw.traceCounts[t] = live.nProcs;
+        sw.traceProcs[t] = malloc(sizeof(Process) * (size_t)live.nProcs);
+        if (!sw.traceProcs[t]) return 1;
+        memcpy(sw.traceProcs[t], live.procs, sizeof(Process) * (size_t)live.nProcs);
+    }
+
+    sweep_run(nConfigs * nTraces, sweepThreads, sweep_one, &sw);
+    return sweep_write_csv(csvPath, traces, nTraces, configs, nConfigs, sw.results) == 0 ? 0 : 1;
 }
 
 /**************************************************
 Method Name: main
 Returns: int
 Input: int argc, char **argv
-Precondition: argv[1] is provided and is a valid input file path.
-Task: Validates arguments, loads process input, starts the 1 Hz timer that drives scheduler_tick(), then waits indefinitely for timer signals.
+Precondition: The last argument is a valid input file path, optionally preceded by -f [-g granularity] or -e alpha [-i initial],
+      -l events.bin / -q for the event log, --trace out.json / --gantt for the timeline, -s to simulate, --rt for real-time hardening and --record/--replay log.bin [--tolerance pct] to record or check decisions.
+      With --sweep grid.txt [--threads N] [--csv out.csv] any number of input files follow.
+Task: Runs a sweep if asked. Otherwise validates arguments, loads process input, starts the 1 Hz timer that drives scheduler_tick() (or ticks a virtual clock when simulating), then flushes the event log after each tick until every process has finished.
 **************************************************/
 int main(int argc, char **argv) {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s input.txt\n", argv[0]);
+    int opt;
+    int bad = 0;
+    const char *logPath = NULL;
+    int textLog = 1;
+    const char *tracePath = NULL;
+    int gantt = 0;
+    int realTime = 0;
+    const char *recordPath = NULL;
+    const char *replayPath = NULL;
+    double tolerance = 25.0;
+    static const struct option longOptions[] = {
+        { "trace", required_argument, NULL, 'T' },
+        { "gantt", no_argument, NULL, 'G' },
+        { "rt", no_argument, NULL, 'R' },
+        { "record", required_argument, NULL, 'W' },
+        { "replay", required_argument, NULL, 'P' },
+        { "tolerance", required_argument, NULL, 'X' },
+        { "sweep", required_argument, NULL, 'S' },
+        { "csv", required_argument, NULL, 'O' },
+        { "threads", required_argument, NULL, 'J' },
+        { "sieve", no_argument, NULL, 'V' },
+        { "worker-threads", required_argument, NULL, 'K' },
+        { "progress", no_argument, NULL, 'Y' },
+        { "checkpoint", required_argument, NULL, 'Z' },
+        { "wide", required_argument, NULL, 'U' },
+        { "kind", required_argument, NULL, 'N' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    live.procs = liveProcs;
+    live.cap = MAX_PROCS;
+    live.running = -1;
+    policy_init(&live.policy);
+    while ((opt = getopt_long(argc, argv, "fg:e:i:l:qsT:G", longOptions, NULL)) != -1) {
+        switch (opt) {
+            case 'f':
+            case 'g':
+            case 'e':
+            case 'i':
+                if (!policy_option(&live.policy, opt, optarg)) bad = 1;
+                break;
+            case 'l':
+                logPath = optarg;
+                break;
+            case 'q':
+                textLog = 0;
+                break;
+            case 's':
+                simulate = 1;
+                break;
+            case 'T':
+                tracePath = optarg;
+                break;
+            case 'G':
+                gantt = 1;
+                break;
+            case 'R':
+                realTime = 1;
+                break;
+            case 'W':
+                recordPath = optarg;
+                break;
+            case 'P':
+                replayPath = optarg;
+                break;
+            case 'X':
+                tolerance = atof(optarg);
+                break;
+            case 'S':
+                sweepPath = optarg;
+                break;
+            case 'O':
+                csvPath = optarg;
+                break;
+            case 'J':
+                sweepThreads = atoi(optarg);
+                break;
+            case 'V':
+                workerSieve = 1;
+                break;
+            case 'K':
+                workerThreads = optarg;
+                break;
+            case 'Y':
+                showProgress = 1;
+                break;
+            case 'Z':
+                checkpointDir = optarg;
+                break;
+            case 'N':
+                workKind = optarg;
+                break;
+            case 'U':
+                wideBits = optarg;
+                if (atoi(wideBits) < 64 || atoi(wideBits) > 127) bad = 1;
+                break;
+            default:
+                bad = 1;
+                break;
+        }
+    }
+    int badSweep = sweepPath && (optind >= argc || logPath || tracePath || gantt || realTime || recordPath || replayPath);
+    if (bad || (!sweepPath && optind != argc - 1) || badSweep || !policy_valid(&live.policy) || (recordPath && replayPath) ||
+        (workerSieve && wideBits)) {
+        fprintf(stderr, "Usage: %s [-f [-g granularity] | -e alpha [-i initial]] [-l events.bin] [-q] [--trace out.json] [--gantt] [--rt] [--record log.bin | --replay log.bin [--tolerance pct]] [--sieve | --wide 64-127] [--worker-threads N] [--kind cpu|mem|cache|io|mixed[:size]] [--progress] [--checkpoint dir] [-s] input.txt\n", argv[0]);
+        fprintf(stderr, "       %s --sweep grid.txt [--threads N] [--csv out.csv] input.txt...\n", argv[0]);
         return 1;
     }
 
+    if (sweepPath) {
+        simulate = 1;
+        return run_sweep(argv + optind, argc - optind);
+    }
+
     // Load process list from the input file into procs[].
-    load_input(argv[1]);
+    load_input(&live, argv[optind]);
+    if (live.policy.fairShare) fair_init(&live.fairQueue, live.policy.minGranularity);
+    if (eventlog_init(logPath, textLog) != 0) return 1;
+    if (tracePath || gantt) {
+        if (trace_init(MAX_PROCS) != 0) {
+            fprintf(stderr, "Could not allocate the trace buffers\n");
+            return 1;
+        }
+        eventlog_set_sink(trace_event);
+    }
+    if (recordPath && replay_record_open(recordPath) != 0) return 1;
+    if (replayPath && replay_check_open(replayPath) != 0) return 1;
+
+    if (simulate) {
+        // Virtual clock: run the ticks back to back, no timer and no children.
+        while (!live.allDone) {
+            scheduler_tick();
+            eventlog_flush();
+        }
+    } else {
+        // Lock memory, run at SCHED_FIFO and keep workers off our CPU so ticks stay on time.
+        if (realTime) rt_harden();
 
-    // Start periodic SIGALRM-based timer, calling scheduler_tick once per second.
-    timer_start(scheduler_tick);
+        // One progress record per process slot, shared with the children.
+        progressFd = progress_create(MAX_PROCS);
+        if (progressFd < 0) perror("Warning: no worker progress page");
 
-    // Sleep until signals arrive. scheduler_tick runs inside the SIGALRM handler chain.
-    while (1) pause();
+        // Start periodic SIGALRM-based timer, calling scheduler_tick once per second.
+        timer_start(scheduler_tick);
+
+        // Sleep until signals arrive. scheduler_tick runs inside the SIGALRM handler chain
+        // and only queues events, so the log is written here in batches off the signal path.
+        while (!live.allDone) {
+            pause();
+            eventlog_flush();
+        }
+    }
 
-    return 0; // Unreachable, but kept for completeness.
+    eventlog_close();
+    print_reports(&live);
+    if (tracePath && trace_write_json(tracePath) == 0) printf("Trace written to %s\n", tracePath);
+    if (gantt) trace_print_gantt(stdout);
+    return replay_finish(stdout, tolerance);
 }
@@ -3,14 +3,17 @@
 // Date: 18 February 2026
 
 #include "timer.h"
+#include "realtime.h"
 
 #include <signal.h>
+#include <stddef.h>
 #include <sys/time.h>
 
 static void (*tick_cb)(void) = 0; // Function pointer for the tick callback
 
 static void alarm_handler(int sig) {
     (void)sig; // Don't use unneeded warning
+    rt_jitter_record(); // Measure how late this tick arrived
     if (tick_cb) tick_cb(); // Calls tick callback
 }
 
@@ -19,7 +22,7 @@ Method Name: timer_start
 Returns: void
 Input: void (*on_tick)(void)
 Precondition: on_tick is a function pointer
-Task: Registers a SIGALRM handler, configures an interval timer,
+Task: Registers a SIGALRM handler, configures an interval timer, and starts tick jitter measurement
  **************************************************/
 void timer_start(void (*on_tick)(void)) {
     tick_cb = on_tick;
@@ -41,5 +44,8 @@ void timer_start(void (*on_tick)(void)) {
     t.it_interval.tv_usec = 0;
 
     setitimer(ITIMER_REAL, &t, NULL);
+
+    // Start measuring tick intervals and lateness against the 1s schedule
+    rt_jitter_start(1000000000L);
 }
 
@@ -0,0 +1,151 @@
+// File: checkpoint.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "checkpoint.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHECKPOINT_MAGIC 0x32504b43u // "CKP2"
+#define DUE_CALLS 256                // Calls to checkpoint_due() between clock reads
+
+// On-disk record: the checkpoint, who wrote it and a checksum so a torn or
+// foreign file is ignored instead of resumed from.
+typedef struct {
+    uint32_t magic;
+    int32_t procNum;
+    Checkpoint state;
+    uint64_t check;
+} CheckpointFile;
+
+static char path[512];    // dir/<procNum>.ckpt, empty when checkpoints are off
+static char tmpPath[520]; // Written first, then renamed over path
+static int owner = -1;
+static unsigned dueCalls = 0;
+static struct timespec lastSave; // Last save (or checkpoint_open), on the monotonic clock
+
+/**************************************************
+Method Name: checksum
+Returns: uint64_t
+Input: const CheckpointFile *f
+Precondition: N/A
+Task: FNV-1a over every field before the checksum.
+ **************************************************/
+static uint64_t checksum(const CheckpointFile *f) {
+    const unsigned char *bytes = (const unsigned char *)f;
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < offsetof(CheckpointFile, check); i++) h = (h ^ bytes[i]) * 1099511628211ULL;
+    return h;
+}
+
+/**************************************************
+Method Name: checkpoint_open
+Returns: int
+Input: const char *dir, int procNum
+Precondition: Called once, before any signal handler can save
+Task: Turns checkpoints on for this process number, kept in
+  dir/<procNum>.ckpt. Returns 0, or -1 if the path is too long.
+ **************************************************/
+int checkpoint_open(const char *dir, int procNum) {
+    int n = snprintf(path, sizeof(path), "%s/%d.ckpt", dir, procNum);
+    if (n < 0 || n >= (int)sizeof(path)) {
+        path[0] = '\0';
+        return -1;
+    }
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    owner = procNum;
+    clock_gettime(CLOCK_MONOTONIC, &lastSave);
+    return 0;
+}
+
+/**************************************************
+Method Name: checkpoint_load
+Returns: int
+Input: Checkpoint *c
+Precondition: checkpoint_open() was called
+Task: Reads this process number's last checkpoint into c. Returns 1 if
+  there was a valid one, 0 if there is none (or it is damaged).
+ **************************************************/
+int checkpoint_load(Checkpoint *c) {
+    if (!path[0]) return 0;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    CheckpointFile f;
+    ssize_t got = read(fd, &f, sizeof(f));
+    close(fd);
+    if (got != (ssize_t)sizeof(f) || f.magic != CHECKPOINT_MAGIC || f.procNum != owner || f.check != checksum(&f)) {
+        return 0;
+    }
+    *c = f.state;
+    return 1;
+}
+
+/**************************************************
+Method Name: checkpoint_save
+Returns: void
+Input: const Checkpoint *c
+Precondition: N/A
+Task: Writes c to a temporary file and renames it over the checkpoint,
+  so a reader sees the old or the new one, never half of each. Uses only
+  async-signal-safe calls, so it may run in a SIGTERM handler. Restarts
+  the CHECKPOINT_SECONDS period even if the write fails. Does nothing if
+  checkpoints are off.
+ **************************************************/
+void checkpoint_save(const Checkpoint *c) {
+    if (!path[0]) return;
+    clock_gettime(CLOCK_MONOTONIC, &lastSave);
+    CheckpointFile f;
+    memset(&f, 0, sizeof(f));
+    f.magic = CHECKPOINT_MAGIC;
+    f.procNum = owner;
+    f.state = *c;
+    f.check = checksum(&f);
+
+    int fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+    int ok = write(fd, &f, sizeof(f)) == (ssize_t)sizeof(f);
+    close(fd);
+    if (ok) rename(tmpPath, path);
+    else unlink(tmpPath);
+}
+
+/**************************************************
+Method Name: checkpoint_due
+Returns: int
+Input: N/A
+Precondition: Called from the search loop, once per block or segment
+Task: Returns 1 once CHECKPOINT_SECONDS have passed since the last save
+  (the clock is read every DUE_CALLS calls), 0 otherwise or if
+  checkpoints are off. The caller then saves, which restarts the period.
+ **************************************************/
+int checkpoint_due(void) {
+    if (!path[0] || ++dueCalls % DUE_CALLS) return 0;
+    struct timespec left;
+    return !checkpoint_left(&left);
+}
+
+/**************************************************
+Method Name: checkpoint_left
+Returns: int
+Input: struct timespec *left
+Precondition: Checkpoints are on
+Task: Sets left to the time until the next periodic checkpoint is due,
+  CHECKPOINT_SECONDS after the last save, and returns 1. Returns 0 if it
+  is already due. Signal loops wait at most left, so signals that wake
+  them do not put the checkpoint off.
+ **************************************************/
+int checkpoint_left(struct timespec *left) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    left->tv_sec = lastSave.tv_sec + CHECKPOINT_SECONDS - now.tv_sec;
+    left->tv_nsec = lastSave.tv_nsec - now.tv_nsec;
+    if (left->tv_nsec < 0) {
+        left->tv_sec--;
+        left->tv_nsec += 1000000000L;
+    }
+    return left->tv_sec >= 0 && (left->tv_sec > 0 || left->tv_nsec > 0);
+}
@@ -0,0 +1,31 @@
+// File: checkpoint.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include <time.h>
+
+#define CHECKPOINT_SECONDS 2 // Time between periodic checkpoints while searching
+
+// Where a worker's search got to. Every candidate below position has been
+// searched (threaded searches may also have searched some above it).
+// With -w, position and highest are offsets from 2^wideBits, so a
+// checkpoint only resumes a search with the same wideBits and kind.
+typedef struct {
+    uint64_t position; // First candidate still to search
+    uint64_t highest;  // Highest prime found so far
+    uint64_t tested;   // Candidates searched so far
+    uint32_t wideBits; // -w bits, 0 without -w
+    uint32_t kind;     // --kind workload (WORK_CPU for the prime search)
+} Checkpoint;
+
+int checkpoint_open(const char *dir, int procNum);
+int checkpoint_load(Checkpoint *c);
+void checkpoint_save(const Checkpoint *c);
+int checkpoint_due(void);
+int checkpoint_left(struct timespec *left);
+
+#endif
@@ -0,0 +1,171 @@
+// File: control.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _GNU_SOURCE
+
+#include "control.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define MAX_CLIENTS 16
+
+static int listenFd = -1;
+static const char *socketPath = NULL;
+static struct pollfd fds[MAX_CLIENTS + 1]; // fds[0] is the listening socket
+static int nFds = 0;
+
+/**************************************************
+Method Name: control_open
+Returns: int
+Input: const char *path
+Precondition: N/A
+Task: Creates the Unix-domain control socket at path (replacing a stale
+  one). Returns 0 on success, -1 on failure.
+ **************************************************/
+int control_open(const char *path) {
+    struct sockaddr_un addr;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Control socket path too long: %s\n", path);
+        return -1;
+    }
+
+    listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        perror("socket");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    if (bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listenFd, MAX_CLIENTS) != 0) {
+        perror("bind/listen");
+        close(listenFd);
+        listenFd = -1;
+        return -1;
+    }
+
+    socketPath = path;
+    fds[0].fd = listenFd;
+    fds[0].events = POLLIN;
+    nFds = 1;
+    return 0;
+}
+
+/**************************************************
+Method Name: drop_client
+Returns: void
+Input: int slot
+Precondition: slot > 0 is a connected client in fds[]
+Task: Closes the client and moves the last client into its slot.
+ **************************************************/
+static void drop_client(int slot) {
+    close(fds[slot].fd);
+    fds[slot] = fds[--nFds];
+}
+
+/**************************************************
+Method Name: serve_client
+Returns: int
+Input: int fd, CtlHandler handler
+Precondition: fd is readable
+Task: Answers every request already queued on fd (so a client that
+  pipelines batches is served in one wakeup). SIGALRM is blocked only
+  while the handler runs, so the tick never sees a half-applied request.
+  Returns -1 when the client hung up.
+ **************************************************/
+static int serve_client(int fd, CtlHandler handler) {
+    char buf[CTL_MAX_REQUEST];
+    sigset_t alarmSet, oldSet;
+    sigemptyset(&alarmSet);
+    sigaddset(&alarmSet, SIGALRM);
+
+    while (1) {
+        ssize_t got = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (got == 0) return -1;
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+
+        CtlReply reply;
+        memset(&reply, 0, sizeof(reply));
+        const CtlRequest *req = (const CtlRequest *)buf;
+        if ((size_t)got < sizeof(CtlRequest) || req->count > CTL_MAX_BATCH ||
+            (size_t)got != sizeof(CtlRequest) + req->count * sizeof(CtlJob)) {
+            // Still fill in the stats, but refuse the request.
+            CtlRequest stats;
+            memset(&stats, 0, sizeof(stats));
+            stats.op = CTL_STATS;
+            sigprocmask(SIG_BLOCK, &alarmSet, &oldSet);
+            handler(&stats, NULL, &reply);
+            sigprocmask(SIG_SETMASK, &oldSet, NULL);
+            reply.status = CTL_BAD_REQUEST;
+        } else {
+            sigprocmask(SIG_BLOCK, &alarmSet, &oldSet);
+            handler(req, (const CtlJob *)(buf + sizeof(CtlRequest)), &reply);
+            sigprocmask(SIG_SETMASK, &oldSet, NULL);
+        }
+
+        while (send(fd, &reply, sizeof(reply), MSG_NOSIGNAL) < 0) {
+            if (errno != EINTR) return -1;
+        }
+    }
+}
+
+/**************************************************
+Method Name: control_serve
+Returns: void
+Input: CtlHandler handler
+Precondition: control_open() succeeded
+Task: Waits for control traffic and answers it. Returns after a timer
+  signal interrupts the wait or after a round of requests is served,
+  so it can replace pause() in the main loop.
+ **************************************************/
+void control_serve(CtlHandler handler) {
+    if (poll(fds, (nfds_t)nFds, -1) < 0) return; // EINTR: a tick ran
+
+    for (int i = nFds - 1; i >= 1; i--) {
+        if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (serve_client(fds[i].fd, handler) < 0) drop_client(i);
+        }
+    }
+
+    if (fds[0].revents & POLLIN) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_CLOEXEC);
+        if (fd >= 0) {
+            if (nFds == MAX_CLIENTS + 1) {
+                close(fd);
+            } else {
+                fds[nFds].fd = fd;
+                fds[nFds].events = POLLIN;
+                nFds++;
+            }
+        }
+    }
+}
+
+/**************************************************
+Method Name: control_close
+Returns: void
+Input: N/A
+Precondition: N/A
+Task: Removes the control socket. Safe to call more than once.
+ **************************************************/
+void control_close(void) {
+    if (listenFd < 0) return;
+    for (int i = 1; i < nFds; i++) close(fds[i].fd);
+    close(listenFd);
+    unlink(socketPath);
+    listenFd = -1;
+    nFds = 0;
+}
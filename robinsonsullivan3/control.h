@@ -0,0 +1,68 @@
+// File: control.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdint.h>
+
+// Control socket protocol. Each request and reply is one SOCK_SEQPACKET
+// message, so batches never need framing.
+
+#define CTL_MAX_BATCH 64 // Jobs per CTL_SUBMIT message
+
+// Request operations
+enum {
+    CTL_SUBMIT = 1, // Add count jobs (CtlJob entries follow the request)
+    CTL_PRIORITY,   // Change the priority of processNum
+    CTL_CANCEL,     // Terminate processNum
+    CTL_STATS,      // Only read the queue stats in the reply
+    CTL_SHUTDOWN    // Exit once every job has finished
+};
+
+// Reply status
+enum {
+    CTL_OK = 0,
+    CTL_BAD_REQUEST,
+    CTL_FULL,       // Process table is full (accepted says how many jobs got in)
+    CTL_NO_SUCH_JOB
+};
+
+typedef struct {
+    int32_t burst;
+    int32_t priority;
+} CtlJob;
+
+typedef struct {
+    uint16_t op;         // CTL_* operation
+    uint16_t count;      // Jobs following a CTL_SUBMIT request
+    int32_t processNum;  // Target of CTL_PRIORITY and CTL_CANCEL
+    int32_t priority;    // New priority for CTL_PRIORITY
+} CtlRequest;
+
+// Every reply carries the current queue stats.
+typedef struct {
+    int32_t status;          // CTL_OK or an error
+    int32_t firstProcessNum; // CTL_SUBMIT: number of the first job, the rest follow in order
+    int32_t accepted;        // CTL_SUBMIT: jobs added
+    int32_t currentTime;     // Scheduler tick
+    int32_t total;           // Jobs known to the scheduler
+    int32_t ready;           // Jobs that have arrived and are waiting for the CPU (queue depth)
+    int32_t running;         // processNum on the CPU, -1 if idle
+    int32_t finished;        // Jobs finished or cancelled
+    int64_t ticks;           // Ticks measured by the jitter monitor
+    int64_t latenessMaxNs;   // Worst tick lateness so far
+    int64_t latenessSumNs;   // Sum of tick lateness (mean = sum / ticks)
+} CtlReply;
+
+#define CTL_MAX_REQUEST (sizeof(CtlRequest) + CTL_MAX_BATCH * sizeof(CtlJob))
+
+// Handles one request and fills in the reply (called with SIGALRM blocked)
+typedef void (*CtlHandler)(const CtlRequest *req, const CtlJob *jobs, CtlReply *reply);
+
+int control_open(const char *path);
+void control_serve(CtlHandler handler);
+void control_close(void);
+
+#endif
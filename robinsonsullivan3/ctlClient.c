@@ -0,0 +1,257 @@
+// File: ctlClient.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "control.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+static int sock = -1;
+
+/**************************************************
+Method Name: now_ns
+Returns: long long
+Input: N/A
+Precondition: N/A
+Task: Returns CLOCK_MONOTONIC in nanoseconds.
+ **************************************************/
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**************************************************
+Method Name: connect_to
+Returns: int
+Input: const char *path
+Precondition: The scheduler was started with -c path
+Task: Connects to the control socket. Returns 0 on success, -1 on failure.
+ **************************************************/
+static int connect_to(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    sock = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (sock < 0 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("connect");
+        return -1;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: call
+Returns: int
+Input: const CtlRequest *req, const CtlJob *jobs, CtlReply *reply
+Precondition: connect_to() succeeded
+Task: Sends one request (with req->count jobs) and waits for its reply.
+  Returns 0 on success, -1 if the scheduler went away.
+ **************************************************/
+static int call(const CtlRequest *req, const CtlJob *jobs, CtlReply *reply) {
+    char buf[CTL_MAX_REQUEST];
+    size_t len = sizeof(CtlRequest) + req->count * sizeof(CtlJob);
+    memcpy(buf, req, sizeof(CtlRequest));
+    if (req->count > 0) memcpy(buf + sizeof(CtlRequest), jobs, req->count * sizeof(CtlJob));
+
+    if (send(sock, buf, len, 0) != (ssize_t)len) {
+        perror("send");
+        return -1;
+    }
+    if (recv(sock, reply, sizeof(*reply), 0) != (ssize_t)sizeof(*reply)) {
+        fprintf(stderr, "Scheduler closed the control socket\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: print_reply
+Returns: void
+Input: const CtlReply *reply
+Precondition: N/A
+Task: Prints the status and queue stats from a reply.
+ **************************************************/
+static void print_reply(const CtlReply *reply) {
+    static const char *status[] = { "ok", "bad request", "process table full", "no such job" };
+    printf("status: %s\n", reply->status >= 0 && reply->status <= CTL_NO_SUCH_JOB ? status[reply->status] : "?");
+    if (reply->accepted > 0) {
+        printf("submitted: %d job(s) starting at process %d\n", reply->accepted, reply->firstProcessNum);
+    }
+    printf("time %d: %d jobs, %d ready, %d finished, running %d\n",
+           reply->currentTime, reply->total, reply->ready, reply->finished, reply->running);
+    if (reply->ticks > 0) {
+        printf("tick lateness: avg %.1f us, max %.1f us over %lld ticks\n",
+               reply->latenessSumNs / 1e3 / reply->ticks, reply->latenessMaxNs / 1e3, (long long)reply->ticks);
+    }
+}
+
+/**************************************************
+Method Name: compare_ll
+Returns: int
+Input: const void *a, const void *b
+Precondition: a and b point to long long values
+Task: qsort comparator for round trip times.
+ **************************************************/
+static int compare_ll(const void *a, const void *b) {
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/**************************************************
+Method Name: flood
+Returns: int
+Input: int jobs, int batch, int rate
+Precondition: connect_to() succeeded, 1 <= batch <= CTL_MAX_BATCH
+Task: Submits jobs (burst 1, priority 10, so they queue behind real work)
+  batch jobs per request, as fast as the scheduler answers or paced to
+  rate jobs per second if rate > 0 so the flood spans several ticks.
+  Reports the intake rate, the request round trip time and the
+  scheduler's tick lateness during the flood. Stops early if the
+  process table fills up.
+ **************************************************/
+static int flood(int jobs, int batch, int rate) {
+    CtlJob entries[CTL_MAX_BATCH];
+    for (int j = 0; j < batch; j++) {
+        entries[j].burst = 1;
+        entries[j].priority = 10;
+    }
+
+    CtlRequest req;
+    CtlReply before, reply;
+    memset(&req, 0, sizeof(req));
+    req.op = CTL_STATS;
+    if (call(&req, NULL, &before) != 0) return 1;
+
+    int requests = (jobs + batch - 1) / batch;
+    long long *rtt = malloc(sizeof(long long) * (size_t)requests);
+    if (!rtt) return 1;
+
+    int accepted = 0, sent = 0;
+    long long start = now_ns();
+    req.op = CTL_SUBMIT;
+    while (accepted < jobs) {
+        if (rate > 0) {
+            // Sleep until this batch is due on the paced schedule.
+            long long due = start + (long long)accepted * 1000000000LL / rate;
+            long long wait = due - now_ns();
+            if (wait > 0) {
+                struct timespec ts = { (time_t)(wait / 1000000000LL), (long)(wait % 1000000000LL) };
+                nanosleep(&ts, NULL);
+            }
+        }
+        req.count = (uint16_t)(jobs - accepted < batch ? jobs - accepted : batch);
+        long long t0 = now_ns();
+        if (call(&req, entries, &reply) != 0) break;
+        rtt[sent++] = now_ns() - t0;
+        accepted += reply.accepted;
+        if (reply.status != CTL_OK) break;
+    }
+    long long elapsed = now_ns() - start;
+
+    req.op = CTL_STATS;
+    req.count = 0;
+    if (call(&req, NULL, &reply) != 0) {
+        free(rtt);
+        return 1;
+    }
+
+    printf("Submitted %d of %d jobs in %d requests of up to %d in %.3f ms: %.0f jobs/s\n",
+           accepted, jobs, sent, batch, elapsed / 1e6, elapsed > 0 ? accepted * 1e9 / elapsed : 0.0);
+    if (accepted < jobs) printf("Stopped early: process table full or request refused\n");
+    if (sent > 0) {
+        qsort(rtt, (size_t)sent, sizeof(long long), compare_ll);
+        printf("Request round trip: median %.1f us, p99 %.1f us, max %.1f us\n",
+               rtt[sent / 2] / 1e3, rtt[(int)((sent - 1) * 0.99)] / 1e3, rtt[sent - 1] / 1e3);
+    }
+    long ticks = (long)(reply.ticks - before.ticks);
+    if (ticks > 0) {
+        printf("Tick lateness during flood: avg %.1f us over %ld ticks (worst since start %.1f us, before flood %.1f us)\n",
+               (reply.latenessSumNs - before.latenessSumNs) / 1e3 / ticks, ticks,
+               reply.latenessMaxNs / 1e3, before.latenessMaxNs / 1e3);
+    } else {
+        printf("No ticks during the flood (took less than a tick)\n");
+    }
+    free(rtt);
+    return 0;
+}
+
+/**************************************************
+Method Name: usage
+Returns: int
+Input: const char *prog
+Precondition: N/A
+Task: Prints the command line forms and returns 1.
+ **************************************************/
+static int usage(const char *prog) {
+    fprintf(stderr, "Usage: %s control.sock submit burst priority [count]\n", prog);
+    fprintf(stderr, "       %s control.sock priority processNum priority\n", prog);
+    fprintf(stderr, "       %s control.sock cancel processNum\n", prog);
+    fprintf(stderr, "       %s control.sock stats | shutdown\n", prog);
+    fprintf(stderr, "       %s control.sock flood jobs batch [jobsPerSecond]\n", prog);
+    return 1;
+}
+
+/**************************************************
+Method Name: main
+Returns: int
+Input: int argc, char **argv
+Precondition: The scheduler is running with a control socket
+Task: Sends one control command, or floods the scheduler with jobs.
+ **************************************************/
+int main(int argc, char **argv) {
+    if (argc < 3) return usage(argv[0]);
+    const char *cmd = argv[2];
+
+    CtlRequest req;
+    CtlReply reply;
+    CtlJob jobs[CTL_MAX_BATCH];
+    memset(&req, 0, sizeof(req));
+
+    if (strcmp(cmd, "submit") == 0 && (argc == 5 || argc == 6)) {
+        int count = argc == 6 ? atoi(argv[5]) : 1;
+        if (count < 1 || count > CTL_MAX_BATCH) return usage(argv[0]);
+        req.op = CTL_SUBMIT;
+        req.count = (uint16_t)count;
+        for (int j = 0; j < count; j++) {
+            jobs[j].burst = atoi(argv[3]);
+            jobs[j].priority = atoi(argv[4]);
+        }
+    } else if (strcmp(cmd, "priority") == 0 && argc == 5) {
+        req.op = CTL_PRIORITY;
+        req.processNum = atoi(argv[3]);
+        req.priority = atoi(argv[4]);
+    } else if (strcmp(cmd, "cancel") == 0 && argc == 4) {
+        req.op = CTL_CANCEL;
+        req.processNum = atoi(argv[3]);
+    } else if (strcmp(cmd, "stats") == 0 && argc == 3) {
+        req.op = CTL_STATS;
+    } else if (strcmp(cmd, "shutdown") == 0 && argc == 3) {
+        req.op = CTL_SHUTDOWN;
+    } else if (strcmp(cmd, "flood") == 0 && (argc == 5 || argc == 6)) {
+        int total = atoi(argv[3]);
+        int batch = atoi(argv[4]);
+        if (total < 1 || batch < 1 || batch > CTL_MAX_BATCH) return usage(argv[0]);
+        if (connect_to(argv[1]) != 0) return 1;
+        int rc = flood(total, batch, argc == 6 ? atoi(argv[5]) : 0);
+        close(sock);
+        return rc;
+    } else {
+        return usage(argv[0]);
+    }
+
+    if (connect_to(argv[1]) != 0) return 1;
+    if (call(&req, jobs, &reply) != 0) return 1;
+    print_reply(&reply);
+    close(sock);
+    return reply.status == CTL_OK ? 0 : 2;
+}
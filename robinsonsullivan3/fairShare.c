@@ -0,0 +1,174 @@
+// File: fairShare.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "fairShare.h"
+
+#include <stddef.h>
+
+#define NICE_0_WEIGHT 1024
+#define VRUNTIME_TICK (1ULL << 20) // Virtual runtime of one tick at nice 0
+
+// Load weight for nice -20 .. 19. Each step is about 1.25x (same table as Linux CFS).
+static const int niceToWeight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
+/**************************************************
+Method Name: fair_weight
+Returns: int
+Input: int nice
+Precondition: N/A
+Task: Returns the load weight for a nice value, clamped to -20 .. 19.
+ **************************************************/
+int fair_weight(int nice) {
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return niceToWeight[nice + 20];
+}
+
+/**************************************************
+Method Name: update_min_vruntime
+Returns: void
+Input: FairQueue *fq, const FairEntity *curr
+Precondition: curr is the running entity or NULL
+Task: Advances minVruntime to the smallest vruntime among the running and
+  queued entities. It never moves backwards.
+ **************************************************/
+static void update_min_vruntime(FairQueue *fq, const FairEntity *curr) {
+    RbNode *first = rb_first(&fq->tree);
+    unsigned long long vr;
+
+    if (curr && first) vr = curr->node.key < first->key ? curr->node.key : first->key;
+    else if (curr) vr = curr->node.key;
+    else if (first) vr = first->key;
+    else return;
+
+    if (vr > fq->minVruntime) fq->minVruntime = vr;
+}
+
+/**************************************************
+Method Name: fair_init
+Returns: void
+Input: FairQueue *fq, int minGranularity
+Precondition: fq points to writable memory
+Task: Initializes an empty run queue.
+ **************************************************/
+void fair_init(FairQueue *fq, int minGranularity) {
+    rb_init(&fq->tree);
+    fq->minVruntime = 0;
+    fq->totalWeight = 0;
+    fq->minGranularity = minGranularity < 1 ? 1 : minGranularity;
+}
+
+/**************************************************
+Method Name: fair_entity_init
+Returns: void
+Input: FairEntity *fe, int id, int nice
+Precondition: id is the owner's index in the scheduler's process table
+Task: Initializes an entity that is not yet runnable.
+ **************************************************/
+void fair_entity_init(FairEntity *fe, int id, int nice) {
+    fe->node.key = 0;
+    fe->node.id = id;
+    fe->weight = fair_weight(nice);
+    fe->queued = 0;
+    fe->sliceTicks = 0;
+    fe->ranTicks = 0;
+    fe->entitledTicks = 0.0;
+}
+
+/**************************************************
+Method Name: fair_enqueue
+Returns: void
+Input: FairQueue *fq, FairEntity *fe
+Precondition: fe is not queued and not running
+Task: Makes fe runnable. An entity that falls behind minVruntime (a new
+  arrival) is placed at minVruntime so it cannot monopolize the CPU.
+ **************************************************/
+void fair_enqueue(FairQueue *fq, FairEntity *fe) {
+    if (fe->node.key < fq->minVruntime) fe->node.key = fq->minVruntime;
+    rb_insert(&fq->tree, &fe->node);
+    fq->totalWeight += fe->weight;
+    fe->queued = 1;
+}
+
+/**************************************************
+Method Name: fair_dequeue
+Returns: void
+Input: FairQueue *fq, FairEntity *fe
+Precondition: fe is queued
+Task: Removes fe from the run queue.
+ **************************************************/
+void fair_dequeue(FairQueue *fq, FairEntity *fe) {
+    rb_erase(&fq->tree, &fe->node);
+    fq->totalWeight -= fe->weight;
+    fe->queued = 0;
+}
+
+/**************************************************
+Method Name: fair_account_tick
+Returns: void
+Input: FairQueue *fq, FairEntity *curr
+Precondition: curr ran during the last tick, or is NULL if the CPU was idle
+Task: Charges curr one tick of weighted virtual runtime and gives every
+  runnable entity its weighted share of the tick as entitlement.
+ **************************************************/
+void fair_account_tick(FairQueue *fq, FairEntity *curr) {
+    long total = fq->totalWeight + (curr ? curr->weight : 0);
+    if (total == 0) return;
+
+    for (RbNode *node = rb_first(&fq->tree); node; node = rb_next(node)) {
+        FairEntity *fe = (FairEntity *)node; // node is the first member
+        fe->entitledTicks += (double)fe->weight / (double)total;
+    }
+
+    if (curr) {
+        curr->entitledTicks += (double)curr->weight / (double)total;
+        curr->ranTicks++;
+        curr->sliceTicks++;
+        curr->node.key += VRUNTIME_TICK * NICE_0_WEIGHT / (unsigned long long)curr->weight;
+    }
+
+    update_min_vruntime(fq, curr);
+}
+
+/**************************************************
+Method Name: fair_pick
+Returns: int
+Input: const FairQueue *fq, const FairEntity *curr
+Precondition: curr is the running entity or NULL
+Task: Returns the id of the entity that should run next, or -1 if nothing
+  is runnable. The running entity keeps the CPU until it has run
+  minGranularity ticks, then yields to any entity with a smaller vruntime.
+ **************************************************/
+int fair_pick(const FairQueue *fq, const FairEntity *curr) {
+    RbNode *first = rb_first(&fq->tree);
+
+    if (!curr) return first ? first->id : -1;
+    if (!first || curr->sliceTicks < fq->minGranularity) return curr->node.id;
+    if (first->key < curr->node.key) return first->id;
+    return curr->node.id;
+}
+
+/**************************************************
+Method Name: fair_switch
+Returns: void
+Input: FairQueue *fq, FairEntity *prev, FairEntity *next
+Precondition: prev is the entity giving up the CPU (NULL if none or if it
+  finished), next is queued
+Task: Puts prev back in the run queue and takes next out to run it.
+ **************************************************/
+void fair_switch(FairQueue *fq, FairEntity *prev, FairEntity *next) {
+    if (prev) fair_enqueue(fq, prev);
+    fair_dequeue(fq, next);
+    next->sliceTicks = 0;
+    update_min_vruntime(fq, next);
+}
@@ -0,0 +1,37 @@
+// File: fairShare.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef FAIR_SHARE_H
+#define FAIR_SHARE_H
+
+#include "rbtree.h"
+
+// Per-process fair scheduling state. node.key is the virtual runtime.
+typedef struct {
+    RbNode node;
+    int weight;           // Load weight from the nice value
+    int queued;           // 1 while the entity is in the run queue tree
+    int sliceTicks;       // Ticks run since the entity was last picked
+    int ranTicks;         // Total ticks actually run
+    double entitledTicks; // Ticks the entity was entitled to by weight
+} FairEntity;
+
+// Run queue of runnable entities. The running entity is kept out of the tree.
+typedef struct {
+    RbTree tree;
+    unsigned long long minVruntime; // Monotonic floor used to place new arrivals
+    long totalWeight;               // Sum of weights of queued entities
+    int minGranularity;             // Ticks a picked entity runs before it can be preempted
+} FairQueue;
+
+int fair_weight(int nice);
+void fair_init(FairQueue *fq, int minGranularity);
+void fair_entity_init(FairEntity *fe, int id, int nice);
+void fair_enqueue(FairQueue *fq, FairEntity *fe);
+void fair_dequeue(FairQueue *fq, FairEntity *fe);
+void fair_account_tick(FairQueue *fq, FairEntity *curr);
+int fair_pick(const FairQueue *fq, const FairEntity *curr);
+void fair_switch(FairQueue *fq, FairEntity *prev, FairEntity *next);
+
+#endif
@@ -0,0 +1,293 @@
+// File: fiber.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _GNU_SOURCE
+
+#include "fiber.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+volatile sig_atomic_t fiberPreempt = 0;
+
+static Fiber *current = NULL;         // Fiber running now, NULL on the scheduler's own stack
+static long long preemptAt = 0;       // When fiberPreempt was raised
+static long preemptYields = 0;        // Yields answering a preemption, and how long each took
+static long long preemptSum = 0, preemptMax = 0;
+
+#if defined(__x86_64__)
+static void *schedulerSp = NULL;      // Scheduler's stack pointer while a fiber runs
+
+// Saves the callee-saved registers, MXCSR and the x87 control word on the
+// current stack, stores the stack pointer in *save, switches to next and
+// restores the same from there. Caller-saved registers are the compiler's
+// problem, since this is an ordinary call.
+void fiber_switch_x86(void **save, void *next);
+__asm__(
+    ".text\n"
+    ".globl fiber_switch_x86\n"
+    ".hidden fiber_switch_x86\n"
+    ".type fiber_switch_x86, @function\n"
+    "fiber_switch_x86:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size fiber_switch_x86, .-fiber_switch_x86\n");
+#else
+static ucontext_t schedulerContext;
+#endif
+
+/**************************************************
+Method Name: now_ns
+Returns: long long
+Input: N/A
+Precondition: N/A
+Task: Returns CLOCK_MONOTONIC in nanoseconds.
+ **************************************************/
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**************************************************
+Method Name: fiber_start
+Returns: void
+Input: N/A
+Precondition: Entered on a new fiber's stack by its first fiber_resume()
+Task: Runs the fiber's body, marks it done and switches back for good.
+ **************************************************/
+static void fiber_start(void) {
+    Fiber *f = current;
+    f->body(f->arg);
+    f->done = 1;
+    fiber_yield();
+    abort(); // A done fiber is never resumed
+}
+
+/**************************************************
+Method Name: fiber_init
+Returns: int
+Input: Fiber *f, FiberBody body, void *arg
+Precondition: N/A
+Task: Maps a stack with a guard page below it and sets f up so that the
+  first fiber_resume(f) runs body(arg) on it with no signals blocked.
+  Safe to call from the timer handler. Returns 0, or -1 if the stack
+  cannot be mapped.
+ **************************************************/
+int fiber_init(Fiber *f, FiberBody body, void *arg) {
+    long page = sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, FIBER_STACK + (size_t)page, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (map == MAP_FAILED) return -1;
+    mprotect(map, (size_t)page, PROT_NONE);
+    f->stack = map + page;
+    f->body = body;
+    f->arg = arg;
+    f->done = 0;
+#if defined(__x86_64__)
+    // Lay out the frame fiber_switch_x86 pops: MXCSR and control word,
+    // six zeroed registers, then fiber_start as the return address, with
+    // a zero above it so fiber_start sees the stack as after a call.
+    uint64_t *top = (uint64_t *)(f->stack + FIBER_STACK);
+    *--top = 0;
+    *--top = (uint64_t)(uintptr_t)fiber_start;
+    for (int i = 0; i < 6; i++) *--top = 0;
+    --top;
+    __asm__ volatile("stmxcsr (%0)\n\tfnstcw 4(%0)" : : "r"(top) : "memory");
+    f->sp = top;
+#else
+    getcontext(&f->context);
+    f->context.uc_stack.ss_sp = f->stack;
+    f->context.uc_stack.ss_size = FIBER_STACK;
+    f->context.uc_link = NULL;
+    sigemptyset(&f->context.uc_sigmask);
+    makecontext(&f->context, fiber_start, 0);
+#endif
+    return 0;
+}
+
+/**************************************************
+Method Name: fiber_resume
+Returns: void
+Input: Fiber *f
+Precondition: Called on the scheduler's stack; f is set up and not done
+Task: Runs f until it yields (or its body returns).
+ **************************************************/
+void fiber_resume(Fiber *f) {
+    current = f;
+#if defined(__x86_64__)
+    fiber_switch_x86(&schedulerSp, f->sp);
+#else
+    swapcontext(&schedulerContext, &f->context);
+#endif
+}
+
+/**************************************************
+Method Name: fiber_yield
+Returns: void
+Input: N/A
+Precondition: Called on a fiber's stack
+Task: Switches back to the fiber_resume() that ran this fiber. If the tick
+  asked for the CPU, first records how long the fiber took to get here.
+ **************************************************/
+void fiber_yield(void) {
+    Fiber *f = current;
+    if (fiberPreempt) {
+        long long waited = now_ns() - preemptAt;
+        fiberPreempt = 0;
+        preemptYields++;
+        preemptSum += waited;
+        if (waited > preemptMax) preemptMax = waited;
+    }
+    current = NULL;
+#if defined(__x86_64__)
+    fiber_switch_x86(&f->sp, schedulerSp);
+#else
+    swapcontext(&f->context, &schedulerContext);
+#endif
+}
+
+/**************************************************
+Method Name: fiber_free
+Returns: void
+Input: Fiber *f
+Precondition: f is not running and its stack is not in use
+Task: Unmaps f's stack. f may be done or parked at a yield.
+ **************************************************/
+void fiber_free(Fiber *f) {
+    if (!f->stack) return;
+    long page = sysconf(_SC_PAGESIZE);
+    munmap(f->stack - page, FIBER_STACK + (size_t)page);
+    f->stack = NULL;
+}
+
+/**************************************************
+Method Name: fiber_preempt
+Returns: void
+Input: N/A
+Precondition: Called from the timer tick
+Task: Asks the running fiber to yield at its next safe point and notes
+  the time, so fiber_yield() can measure the delay.
+ **************************************************/
+void fiber_preempt(void) {
+    if (fiberPreempt) return;
+    preemptAt = now_ns();
+    fiberPreempt = 1;
+}
+
+/**************************************************
+Method Name: fiber_stats
+Returns: void
+Input: long *yields, double *meanNs, double *maxNs
+Precondition: N/A
+Task: Reports how many times a fiber yielded for fiber_preempt() and the
+  mean and maximum time from the request to the yield.
+ **************************************************/
+void fiber_stats(long *yields, double *meanNs, double *maxNs) {
+    *yields = preemptYields;
+    *meanNs = preemptYields > 0 ? (double)preemptSum / preemptYields : 0.0;
+    *maxNs = (double)preemptMax;
+}
+
+/**************************************************
+Method Name: fiber_method
+Returns: const char *
+Input: N/A
+Precondition: N/A
+Task: Names the stack switch this build uses, for the reports.
+ **************************************************/
+const char *fiber_method(void) {
+#if defined(__x86_64__)
+    return "x86-64 register swap";
+#else
+    return "swapcontext";
+#endif
+}
+
+/**************************************************
+Method Name: yield_forever
+Returns: void
+Input: void *arg
+Precondition: Body of the fiber_switch_ns() fiber
+Task: Yields every time it is resumed.
+ **************************************************/
+static void yield_forever(void *arg) {
+    (void)arg;
+    while (1) fiber_yield();
+}
+
+/**************************************************
+Method Name: fiber_switch_ns
+Returns: double
+Input: long rounds
+Precondition: Called on the scheduler's stack with no fiber running
+Task: Times rounds resume and yield pairs of an empty fiber and returns
+  nanoseconds per pair (two stack switches), or -1 if no stack could be
+  mapped.
+ **************************************************/
+double fiber_switch_ns(long rounds) {
+    Fiber f;
+    if (fiber_init(&f, yield_forever, NULL) < 0) return -1.0;
+    fiber_resume(&f); // Fault in the stack first
+    long long start = now_ns();
+    for (long i = 0; i < rounds; i++) fiber_resume(&f);
+    long long elapsed = now_ns() - start;
+    fiber_free(&f);
+    return (double)elapsed / rounds;
+}
+
+/**************************************************
+Method Name: fiber_stop_ns
+Returns: double
+Input: long rounds
+Precondition: Called before the scheduler has children of its own
+Task: The same round trip in the fork model: forks a child that spins,
+  then rounds times stops it with SIGSTOP and continues it with SIGCONT,
+  waiting for the kernel to report each. Returns nanoseconds per round
+  (a lower bound for SIGTSTP and SIGCONT, which also run the worker's
+  handlers), or -1 if the fork fails.
+ **************************************************/
+double fiber_stop_ns(long rounds) {
+    pid_t pid = fork();
+    if (pid < 0) return -1.0;
+    if (pid == 0) {
+        while (1) { }
+    }
+    int status;
+    long long start = now_ns();
+    for (long i = 0; i < rounds; i++) {
+        kill(pid, SIGSTOP);
+        waitpid(pid, &status, WUNTRACED);
+        kill(pid, SIGCONT);
+        waitpid(pid, &status, WCONTINUED);
+    }
+    long long elapsed = now_ns() - start;
+    kill(pid, SIGKILL);
+    waitpid(pid, &status, 0);
+    return (double)elapsed / rounds;
+}
@@ -0,0 +1,48 @@
+// File: fiber.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef FIBER_H
+#define FIBER_H
+
+#include <signal.h>
+#include <stdint.h>
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+#define FIBER_STACK (256u << 10) // Per fiber; the timer handler also runs on the stack of the fiber it interrupts
+
+typedef void (*FiberBody)(void *arg);
+
+// A coroutine run inside the scheduler process. It runs on its own stack
+// until it calls fiber_yield(), which returns to the fiber_resume() that
+// started it. Switching is a hand-written register swap on x86-64 and
+// swapcontext() elsewhere.
+typedef struct {
+#if defined(__x86_64__)
+    void *sp;            // Saved stack pointer while switched out
+#else
+    ucontext_t context;
+#endif
+    char *stack;         // FIBER_STACK bytes above a guard page
+    FiberBody body;
+    void *arg;
+    int done;            // body returned; the fiber must not be resumed again
+} Fiber;
+
+// Set by fiber_preempt() (from the timer tick); the running fiber checks
+// it at its safe points and yields.
+extern volatile sig_atomic_t fiberPreempt;
+
+int fiber_init(Fiber *f, FiberBody body, void *arg);
+void fiber_resume(Fiber *f);
+void fiber_yield(void);
+void fiber_free(Fiber *f);
+void fiber_preempt(void);
+void fiber_stats(long *yields, double *meanNs, double *maxNs);
+const char *fiber_method(void);
+double fiber_switch_ns(long rounds);
+double fiber_stop_ns(long rounds);
+
+#endif
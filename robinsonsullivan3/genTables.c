@@ -0,0 +1,130 @@
+// File: genTables.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define SMALL_PRIMES 45    // Odd primes below 200, primality.c
+#define PREFILTER_PRIMES 46 // 2 and the odd primes below 200, primeKernels.c
+#define PREFILTER_LANES 48
+#define PRESIEVE_PRIMES 17 // Odd primes below 64, sieve.c
+#define WHEEL 210          // 2 * 3 * 5 * 7
+
+/**************************************************
+Method Name: is_small_prime
+Returns: int
+Input: uint32_t n
+Precondition: N/A
+Task: Trial division, only ever run here at build time.
+ **************************************************/
+static int is_small_prime(uint32_t n) {
+    if (n < 2) return 0;
+    for (uint32_t d = 2; d * d <= n; d++) {
+        if (n % d == 0) return 0;
+    }
+    return 1;
+}
+
+/**************************************************
+Method Name: inverse_u64
+Returns: uint64_t
+Input: uint64_t n
+Precondition: n is odd
+Task: Returns n^-1 mod 2^64 by Newton iteration.
+ **************************************************/
+static uint64_t inverse_u64(uint64_t n) {
+    uint64_t x = n;
+    for (int i = 0; i < 5; i++) x *= 2 - n * x;
+    return x;
+}
+
+/**************************************************
+Method Name: gcd
+Returns: uint32_t
+Input: uint32_t a, uint32_t b
+Precondition: N/A
+Task: Greatest common divisor.
+ **************************************************/
+static uint32_t gcd(uint32_t a, uint32_t b) {
+    while (b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**************************************************
+Method Name: main
+Returns: int
+Input: N/A
+Precondition: Run as ./genTables > primeTables.h
+Task: Writes the constant tables the workers used to build at startup:
+  the small primes with their inverses for divisibility tests, the
+  pre-filter and pre-sieve primes, the mod 210 wheel and the Miller-Rabin
+  witnesses.
+ **************************************************/
+int main(void) {
+    printf("// File: primeTables.h\n");
+    printf("// Author: Samantha Robinson, Elizabeth Sullivan\n");
+    printf("// Date: 18 October 2026\n");
+    printf("// Generated by genTables.c, do not edit. To regenerate:\n");
+    printf("//   gcc genTables.c -o genTables && ./genTables > primeTables.h\n\n");
+    printf("#ifndef PRIME_TABLES_H\n#define PRIME_TABLES_H\n\n#include <stdint.h>\n\n");
+
+    printf("// Divisibility by an odd prime p without a division: n is a multiple of p\n");
+    printf("// exactly when n * p^-1 (mod 2^64) <= (2^64 - 1) / p.\n");
+    printf("typedef struct {\n    uint64_t p;\n    uint64_t inverse;\n    uint64_t limit;\n} SmallPrime;\n\n");
+    printf("#define SMALL_PRIME_COUNT %d\n", SMALL_PRIMES);
+    printf("static const SmallPrime smallPrimeTable[SMALL_PRIME_COUNT] = {\n");
+    int count = 0;
+    for (uint32_t p = 3; count < SMALL_PRIMES; p += 2) {
+        if (!is_small_prime(p)) continue;
+        printf("    { %3u, 0x%016llxULL, 0x%016llxULL },\n", p, (unsigned long long)inverse_u64(p),
+               (unsigned long long)(UINT64_MAX / p));
+        count++;
+    }
+    printf("};\n\n");
+
+    printf("// Pre-filter lanes: 2 and the odd primes below 200, padded with 3 to whole vectors.\n");
+    printf("static const uint32_t prefilterPrimeTable[%d] = {", PREFILTER_LANES);
+    count = 0;
+    for (uint32_t p = 2; count < PREFILTER_PRIMES; p++) {
+        if (!is_small_prime(p)) continue;
+        printf("%s%u,", count % 16 ? " " : "\n    ", p);
+        count++;
+    }
+    for (; count < PREFILTER_LANES; count++) printf(" 3,");
+    printf("\n};\n\n");
+
+    printf("// Odd primes below 64 that the sieve pre-marks, with 64^-1 mod p.\n");
+    printf("static const uint32_t presievePrimeTable[%d][2] = {", PRESIEVE_PRIMES);
+    count = 0;
+    for (uint32_t p = 3; p < 64; p += 2) {
+        if (!is_small_prime(p)) continue;
+        uint32_t inverse = 0;
+        for (uint32_t k = 1; k < p; k++) {
+            if (64 * k % p == 1) inverse = k;
+        }
+        printf("%s{ %u, %u },", count % 6 ? " " : "\n    ", p, inverse);
+        count++;
+    }
+    printf("\n};\n\n");
+
+    printf("// Mod 210 wheel: for every residue r, the distance to the next residue at or\n");
+    printf("// after r that is coprime to 2, 3, 5 and 7 (48 of the 210 are).\n");
+    printf("#define WHEEL_MODULUS %d\n", WHEEL);
+    printf("static const uint8_t wheelAdvance[WHEEL_MODULUS] = {");
+    for (uint32_t r = 0; r < WHEEL; r++) {
+        uint32_t d = 0;
+        while (gcd((r + d) % WHEEL, WHEEL) != 1) d++;
+        printf("%s%u,", r % 21 ? " " : "\n    ", d);
+    }
+    printf("\n};\n\n");
+
+    printf("// Miller-Rabin witnesses with no false positives below 2^64.\n");
+    printf("static const uint64_t millerRabinWitnesses[7] = { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };\n\n");
+    printf("#endif\n");
+    return 0;
+}
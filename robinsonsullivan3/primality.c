@@ -0,0 +1,438 @@
+// File: primality.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "primality.h"
+#include "primeTables.h"
+
+typedef unsigned __int128 u128;
+
+/**************************************************
+Method Name: inverse_u64
+Returns: uint64_t
+Input: uint64_t n
+Precondition: n is odd
+Task: Returns n^-1 mod 2^64 by Newton iteration (each step doubles the
+  number of correct low bits, starting from 3).
+ **************************************************/
+static uint64_t inverse_u64(uint64_t n) {
+    uint64_t x = n;
+    for (int i = 0; i < 5; i++) x *= 2 - n * x;
+    return x;
+}
+
+/**************************************************
+Method Name: redc
+Returns: uint64_t
+Input: u128 t, uint64_t n, uint64_t nInv
+Precondition: n is odd, nInv = n^-1 mod 2^64, t < n * 2^64
+Task: Montgomery reduction: returns t * 2^-64 mod n. Subtracting the
+  high halves keeps every step inside 64 bits, so n may use all 64.
+ **************************************************/
+static inline uint64_t redc(u128 t, uint64_t n, uint64_t nInv) {
+    uint64_t m = (uint64_t)t * nInv;
+    uint64_t hi = (uint64_t)(t >> 64);
+    uint64_t mn = (uint64_t)(((u128)m * n) >> 64);
+    return hi >= mn ? hi - mn : hi - mn + n;
+}
+
+/**************************************************
+Method Name: mont_mul
+Returns: uint64_t
+Input: uint64_t a, uint64_t b, uint64_t n, uint64_t nInv
+Precondition: a and b are in Montgomery form modulo n
+Task: Returns a * b in Montgomery form.
+ **************************************************/
+static inline uint64_t mont_mul(uint64_t a, uint64_t b, uint64_t n, uint64_t nInv) {
+    return redc((u128)a * b, n, nInv);
+}
+
+/**************************************************
+Method Name: miller_rabin_u64
+Returns: int
+Input: uint64_t n
+Precondition: n is odd and greater than 199
+Task: Deterministic Miller-Rabin with the witnesses 2, 325, 9375, 28178,
+  450775, 9780504 and 1795265022, which has no false positives below
+  2^64, in Montgomery form with 128-bit intermediate products.
+ **************************************************/
+int miller_rabin_u64(uint64_t n) {
+    // n - 1 = d * 2^s with d odd
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+
+    uint64_t nInv = inverse_u64(n);
+    uint64_t r1 = (0 - n) % n;                   // 2^64 mod n, i.e. 1 in Montgomery form
+    uint64_t r2 = (uint64_t)(((u128)r1 * r1) % n); // 2^128 mod n, converts into Montgomery form
+    uint64_t minusOne = n - r1;                  // n - 1 in Montgomery form
+
+    for (int w = 0; w < (int)(sizeof(millerRabinWitnesses) / sizeof(millerRabinWitnesses[0])); w++) {
+        uint64_t a = millerRabinWitnesses[w] % n;
+        if (a == 0) continue;
+
+        // x = a^d mod n
+        uint64_t base = mont_mul(a, r2, n, nInv);
+        uint64_t x = r1;
+        for (uint64_t e = d; e; e >>= 1) {
+            if (e & 1) x = mont_mul(x, base, n, nInv);
+            base = mont_mul(base, base, n, nInv);
+        }
+        if (x == r1 || x == minusOne) continue;
+
+        int composite = 1;
+        for (int r = 1; r < s; r++) {
+            x = mont_mul(x, x, n, nInv);
+            if (x == minusOne) {
+                composite = 0;
+                break;
+            }
+        }
+        if (composite) return 0;
+    }
+    return 1;
+}
+
+/**************************************************
+Method Name: is_prime_u64
+Returns: int
+Input: uint64_t n
+Precondition: N/A
+Task: Returns 1 if n is prime. Small factors are rejected first, then
+  miller_rabin_u64() decides.
+ **************************************************/
+int is_prime_u64(uint64_t n) {
+    if (n < 2) return 0;
+    if ((n & 1) == 0) return n == 2;
+    for (int i = 0; i < SMALL_PRIME_COUNT; i++) {
+        if (n * smallPrimeTable[i].inverse <= smallPrimeTable[i].limit) return n == smallPrimeTable[i].p;
+    }
+    uint64_t largest = smallPrimeTable[SMALL_PRIME_COUNT - 1].p;
+    if (n < largest * largest) return 1;
+    return miller_rabin_u64(n);
+}
+
+/**************************************************
+Method Name: next_prime_u64
+Returns: uint64_t
+Input: uint64_t n
+Precondition: n is below the largest 64-bit prime
+Task: Returns the smallest prime >= n. Past 7 only numbers on the mod 210
+  wheel are tested, 48 of every 210.
+ **************************************************/
+uint64_t next_prime_u64(uint64_t n) {
+    while (n <= 7) {
+        if (is_prime_u64(n)) return n;
+        n++;
+    }
+    for (n += wheelAdvance[n % WHEEL_MODULUS]; !is_prime_u64(n); n += wheelAdvance[n % WHEEL_MODULUS]) n++;
+    return n;
+}
+
+// Montgomery arithmetic modulo a 128-bit n with R = 2^128.
+typedef struct {
+    u128 n;
+    u128 nInv;     // n^-1 mod 2^128
+    u128 one;      // R mod n, i.e. 1 in Montgomery form
+    u128 minusOne; // n - 1 in Montgomery form
+} Mont128;
+
+/**************************************************
+Method Name: mul_wide
+Returns: void
+Input: u128 a, u128 b, u128 *hi, u128 *lo
+Precondition: N/A
+Task: Full 256-bit product a * b from four 64 x 64 bit multiplies.
+ **************************************************/
+static inline void mul_wide(u128 a, u128 b, u128 *hi, u128 *lo) {
+    uint64_t a0 = (uint64_t)a, a1 = (uint64_t)(a >> 64);
+    uint64_t b0 = (uint64_t)b, b1 = (uint64_t)(b >> 64);
+    u128 p00 = (u128)a0 * b0, p01 = (u128)a0 * b1, p10 = (u128)a1 * b0, p11 = (u128)a1 * b1;
+    u128 mid = (p00 >> 64) + (uint64_t)p01 + (uint64_t)p10; // At most 3 * 2^64
+    *lo = (mid << 64) | (uint64_t)p00;
+    *hi = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+}
+
+/**************************************************
+Method Name: mont_mul128
+Returns: u128
+Input: u128 a, u128 b, const Mont128 *m
+Precondition: a and b are in Montgomery form modulo m->n
+Task: Returns a * b in Montgomery form. Same reduction as redc() one size
+  up: m = t * n^-1 mod 2^128 makes the low halves of t and m * n equal, so
+  only the high halves are subtracted and n may use all 128 bits.
+ **************************************************/
+static inline u128 mont_mul128(u128 a, u128 b, const Mont128 *m) {
+    u128 hi, lo, mnHi, mnLo;
+    mul_wide(a, b, &hi, &lo);
+    mul_wide(lo * m->nInv, m->n, &mnHi, &mnLo);
+    return hi >= mnHi ? hi - mnHi : hi - mnHi + m->n;
+}
+
+/**************************************************
+Method Name: add_mod128
+Returns: u128
+Input: u128 a, u128 b, u128 n
+Precondition: a, b < n
+Task: Returns a + b mod n without overflowing when n is above 2^127.
+ **************************************************/
+static inline u128 add_mod128(u128 a, u128 b, u128 n) {
+    return a >= n - b ? a - (n - b) : a + b;
+}
+
+/**************************************************
+Method Name: sub_mod128
+Returns: u128
+Input: u128 a, u128 b, u128 n
+Precondition: a, b < n
+Task: Returns a - b mod n.
+ **************************************************/
+static inline u128 sub_mod128(u128 a, u128 b, u128 n) {
+    return a >= b ? a - b : a - b + n;
+}
+
+/**************************************************
+Method Name: mont_init128
+Returns: void
+Input: Mont128 *m, u128 n
+Precondition: n is odd and above 2^64
+Task: Sets up Montgomery arithmetic modulo n. The inverse takes six Newton
+  steps (3 correct bits doubled to 192), and R mod n is the only division.
+ **************************************************/
+static void mont_init128(Mont128 *m, u128 n) {
+    u128 x = n;
+    for (int i = 0; i < 6; i++) x *= 2 - n * x;
+    m->n = n;
+    m->nInv = x;
+    m->one = (0 - n) % n;
+    m->minusOne = n - m->one;
+}
+
+/**************************************************
+Method Name: mont_small128
+Returns: u128
+Input: int64_t k, const Mont128 *m
+Precondition: |k| < n
+Task: Returns the small signed integer k in Montgomery form by doubling
+  and adding R mod n, which needs no R^2 mod n.
+ **************************************************/
+static u128 mont_small128(int64_t k, const Mont128 *m) {
+    uint64_t a = k < 0 ? -(uint64_t)k : (uint64_t)k;
+    u128 x = 0, y = m->one;
+    for (; a; a >>= 1) {
+        if (a & 1) x = add_mod128(x, y, m->n);
+        y = add_mod128(y, y, m->n);
+    }
+    return k < 0 && x ? m->n - x : x;
+}
+
+/**************************************************
+Method Name: top_bit128
+Returns: int
+Input: u128 n
+Precondition: n > 0
+Task: Returns the index of the highest set bit of n.
+ **************************************************/
+static inline int top_bit128(u128 n) {
+    uint64_t hi = (uint64_t)(n >> 64);
+    return hi ? 127 - __builtin_clzll(hi) : 63 - __builtin_clzll((uint64_t)n);
+}
+
+/**************************************************
+Method Name: sprp_base2_u128
+Returns: int
+Input: const Mont128 *m
+Precondition: m->n is odd and above 2^64
+Task: Strong probable prime test to base 2. The power is taken left to
+  right, so multiplying by the base is a modular doubling instead of a
+  Montgomery multiply and a third of the multiplies are saved.
+ **************************************************/
+static int sprp_base2_u128(const Mont128 *m) {
+    u128 d = m->n - 1;
+    int s = __builtin_ctzll((uint64_t)d) ? __builtin_ctzll((uint64_t)d) : 64 + __builtin_ctzll((uint64_t)(d >> 64));
+    d >>= s;
+
+    u128 x = add_mod128(m->one, m->one, m->n);
+    for (int bit = top_bit128(d) - 1; bit >= 0; bit--) {
+        x = mont_mul128(x, x, m);
+        if ((d >> bit) & 1) x = add_mod128(x, x, m->n);
+    }
+    if (x == m->one || x == m->minusOne) return 1;
+    for (int r = 1; r < s; r++) {
+        x = mont_mul128(x, x, m);
+        if (x == m->minusOne) return 1;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: jacobi_u128
+Returns: int
+Input: int64_t a, u128 n
+Precondition: n is odd
+Task: Returns the Jacobi symbol (a/n) (1, -1, or 0 if they share a factor).
+ **************************************************/
+static int jacobi_u128(int64_t a, u128 n) {
+    int result = 1;
+    if (a < 0) {
+        a = -a;
+        if ((n & 3) == 3) result = -result; // (-1/n)
+    }
+    u128 x = (u128)a % n;
+    while (x) {
+        while ((x & 1) == 0) {
+            x >>= 1;
+            if ((n & 7) == 3 || (n & 7) == 5) result = -result;
+        }
+        u128 t = x;
+        x = n;
+        n = t;
+        if ((x & 3) == 3 && (n & 3) == 3) result = -result;
+        x %= n;
+    }
+    return n == 1 ? result : 0;
+}
+
+/**************************************************
+Method Name: is_square_u128
+Returns: int
+Input: u128 n
+Precondition: n > 0
+Task: Returns 1 if n is a perfect square. Newton's method from a power of
+  two above the root.
+ **************************************************/
+static int is_square_u128(u128 n) {
+    u128 x = (u128)1 << (top_bit128(n) / 2 + 1);
+    while (1) {
+        u128 y = (x + n / x) >> 1;
+        if (y >= x) break;
+        x = y;
+    }
+    return x * x == n;
+}
+
+/**************************************************
+Method Name: extra_strong_lucas_u128
+Returns: int
+Input: const Mont128 *m
+Precondition: m->n is odd, above 2^64 and has no factor below 200
+Task: Extra strong Lucas probable prime test: Q = 1 and P the first of
+  3, 4, 5, ... with (D/n) = -1 for D = P^2 - 4. With n + 1 = d * 2^s, n
+  passes if U_d = 0 and V_d = +-2, or V_(d*2^r) = 0 for some r < s - 1.
+  With Q = 1 only V is needed (D U_d = 2 V_(d+1) - P V_d, and D is a unit),
+  so each bit of d costs two multiplies instead of four for Selfridge's Q.
+ **************************************************/
+static int extra_strong_lucas_u128(const Mont128 *m) {
+    u128 n = m->n;
+    int64_t p = 3;
+    while (1) {
+        int j = jacobi_u128(p * p - 4, n);
+        if (j == -1) break;
+        if (j == 0) return 0;                    // P^2 - 4 < n shares a factor with n
+        if (p == 10 && is_square_u128(n)) return 0; // No P exists for a square
+        p++;
+    }
+    u128 pm = mont_small128(p, m), two = add_mod128(m->one, m->one, n);
+
+    u128 d = n + 1;
+    int s = __builtin_ctzll((uint64_t)d) ? __builtin_ctzll((uint64_t)d) : 64 + __builtin_ctzll((uint64_t)(d >> 64));
+    d >>= s;
+
+    // Lucas ladder: (V_k, V_k+1) -> (V_2k, V_2k+1) or (V_2k+1, V_2k+2) with
+    // V_2k = V_k^2 - 2 and V_2k+1 = V_k V_k+1 - P, starting from V_1 = P, V_2 = P^2 - 2.
+    u128 v = pm, w = sub_mod128(mont_mul128(pm, pm, m), two, n);
+    for (int bit = top_bit128(d) - 1; bit >= 0; bit--) {
+        if ((d >> bit) & 1) {
+            v = sub_mod128(mont_mul128(v, w, m), pm, n);
+            w = sub_mod128(mont_mul128(w, w, m), two, n);
+        } else {
+            w = sub_mod128(mont_mul128(v, w, m), pm, n);
+            v = sub_mod128(mont_mul128(v, v, m), two, n);
+        }
+    }
+    if ((v == two || v == n - two) && mont_mul128(pm, v, m) == add_mod128(w, w, n)) return 1;
+    for (int r = 0; r < s - 1; r++) {
+        if (v == 0) return 1;
+        v = sub_mod128(mont_mul128(v, v, m), two, n);
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: bpsw_u128
+Returns: int
+Input: unsigned __int128 n
+Precondition: n is odd, has no factor below 200 and is above 2^64
+Task: Baillie-PSW: a strong probable prime test to base 2 followed by an
+  extra strong Lucas test, both in 128-bit Montgomery form. No composite
+  is known to pass both. Almost every composite fails the cheap base 2
+  test, so the Lucas test mostly runs on primes.
+ **************************************************/
+int bpsw_u128(unsigned __int128 n) {
+    Mont128 m;
+    mont_init128(&m, n);
+    return sprp_base2_u128(&m) && extra_strong_lucas_u128(&m);
+}
+
+/**************************************************
+Method Name: is_prime_u128
+Returns: int
+Input: unsigned __int128 n
+Precondition: N/A
+Task: Returns 1 if n is prime. Numbers below 2^64 take the exact 64-bit
+  path. Above it, n is reduced modulo products of the small primes (a few
+  128-bit divisions instead of one per prime), each residue is checked
+  with the 64-bit divisibility test, and bpsw_u128() decides.
+ **************************************************/
+int is_prime_u128(unsigned __int128 n) {
+    if ((n >> 64) == 0) return is_prime_u64((uint64_t)n);
+    if ((n & 1) == 0) return 0;
+    int first = 0;
+    uint64_t product = 1;
+    for (int i = 0; i <= SMALL_PRIME_COUNT; i++) {
+        if (i == SMALL_PRIME_COUNT || product > UINT64_MAX / smallPrimeTable[i].p) {
+            uint64_t r = (uint64_t)(n % product);
+            for (int j = first; j < i; j++) {
+                if (r * smallPrimeTable[j].inverse <= smallPrimeTable[j].limit) return 0;
+            }
+            first = i;
+            product = 1;
+        }
+        if (i < SMALL_PRIME_COUNT) product *= smallPrimeTable[i].p;
+    }
+    return bpsw_u128(n);
+}
+
+/**************************************************
+Method Name: next_prime_u128
+Returns: unsigned __int128
+Input: unsigned __int128 n
+Precondition: A prime >= n fits in 128 bits
+Task: Returns the smallest prime >= n, stepping along the mod 210 wheel
+  like next_prime_u64().
+ **************************************************/
+unsigned __int128 next_prime_u128(unsigned __int128 n) {
+    if ((n >> 64) == 0 && (uint64_t)n <= UINT64_MAX - 58) return next_prime_u64((uint64_t)n);
+    for (n += wheelAdvance[n % WHEEL_MODULUS]; !is_prime_u128(n); n += wheelAdvance[n % WHEEL_MODULUS]) n++;
+    return n;
+}
+
+/**************************************************
+Method Name: u128_to_string
+Returns: char *
+Input: unsigned __int128 n, char *buf
+Precondition: buf has room for U128_DIGITS + 1 characters
+Task: Writes n in decimal (printf has no 128-bit conversion) and returns
+  buf. Async-signal-safe, so the workers' handlers can use it.
+ **************************************************/
+char *u128_to_string(unsigned __int128 n, char *buf) {
+    char digits[U128_DIGITS];
+    int len = 0;
+    do {
+        digits[len++] = (char)('0' + n % 10);
+        n /= 10;
+    } while (n);
+    for (int i = 0; i < len; i++) buf[i] = digits[len - 1 - i];
+    buf[len] = '\0';
+    return buf;
+}
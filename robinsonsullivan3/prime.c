@@ -6,34 +6,58 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <unistd.h>
+#include <time.h>
+#include "primality.h"
+#include "sieve.h"
+#include "primeKernels.h"
+#include "searchPool.h"
+#include "progress.h"
+#include "checkpoint.h"
+#include "workload.h"
 
 static int g_pnum = -1;
 static int g_pri  = -1;
 
 static unsigned long long current = 1234567890ULL;
 static unsigned long long highestPrime = 0ULL;
+static unsigned long long tested = 0ULL;
+static Sieve *threadSieves = NULL; // One sieve per pool thread with -t and -s
+static unsigned long long resumedTested = 0ULL; // Numbers a resumed checkpoint had already tested
+static int checkpointing = 0;                   // -c dir saves and resumes the search position
+static unsigned __int128 origin = 0;            // -w bits: 2^bits, and current and highestPrime are offsets from it
+static uint32_t wideBits = 0;                   // -w bits, 0 without -w (recorded in the checkpoint)
+static Workload work;                           // --kind: what the job spends its time on (default cpu, the prime search)
 
-static int isPrime(unsigned long long n) {
-    if (n < 2ULL) return 0;
-    if (n % 2ULL == 0ULL) return n == 2ULL;
-    for (unsigned long long i = 3ULL; i * i <= n; i += 2ULL) {
-        if (n % i == 0ULL) return 0;
-    }
-    return 1;
+// The highest prime in decimal. With -w it is above 2^64, so it is
+// formatted by hand from origin + offset; async-signal-safe.
+static const char *highestText(void) {
+    static char buf[U128_DIGITS + 1];
+    return u128_to_string(origin + highestPrime, buf);
+}
+
+// Candidates tested per second of CPU time, so time spent suspended does not count.
+static double testedPerSecond(void) {
+    struct timespec cpu;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    double seconds = cpu.tv_sec + cpu.tv_nsec / 1e9;
+    return seconds > 0 ? (tested - resumedTested) / seconds : 0.0;
 }
 
-static unsigned long long nextPrime(unsigned long long x) {
-    while (!isPrime(x)) x++;
-    return x;
+// Writes the search position (current) and counters to the -c checkpoint.
+// Async-signal-safe, so handle_term can call it. Does nothing without -c.
+static void saveCheckpoint(void) {
+    Checkpoint c = { current, highestPrime, tested, wideBits, (uint32_t)work.kind };
+    checkpoint_save(&c);
 }
 
 static void handle_tstp(int sig) {
     (void)sig;
     printf("Process %d: My priority is %d, my PID is %d: I am about to be suspended... "
-           "Highest prime number I found is %llu.\n",
-           g_pnum, g_pri, (int)getpid(), highestPrime);
+           "Highest prime number I found is %s.\n",
+           g_pnum, g_pri, (int)getpid(), highestText());
     fflush(stdout);
     raise(SIGSTOP);
 }
@@ -41,49 +65,365 @@ static void handle_tstp(int sig) {
 static void handle_cont(int sig) {
     (void)sig;
     printf("Process %d: My priority is %d, my PID is %d: I just got resumed. "
-           "Highest prime number I found is %llu.\n",
-           g_pnum, g_pri, (int)getpid(), highestPrime);
+           "Highest prime number I found is %s.\n",
+           g_pnum, g_pri, (int)getpid(), highestText());
     fflush(stdout);
 }
 
 static void handle_term(int sig) {
     (void)sig;
+    saveCheckpoint();
+    char other[96];
+    workload_format(&work, other, sizeof(other));
     printf("Process %d: My priority is %d, my PID is %d: I completed my task and I am exiting. "
-           "Highest prime number I found is %llu.\n",
-           g_pnum, g_pri, (int)getpid(), highestPrime);
+           "Highest prime number I found is %s. I tested %llu numbers (%.0f per second).%s\n",
+           g_pnum, g_pri, (int)getpid(), highestText(), tested, testedPerSecond(), other);
     fflush(stdout);
     _exit(0);
 }
 
+// Searches one sieve segment at a time; highestPrime and tested change at
+// segment boundaries, so the handlers report the last finished segment.
+static void searchSieve(void) {
+    Sieve sieve;
+    // Base primes start at sqrt(4 * current) and are extended whenever the search outruns them.
+    if (sieve_init(&sieve, current, 4ULL * current, 0) < 0) {
+        fprintf(stderr, "prime: cannot allocate the sieve\n");
+        exit(1);
+    }
+    while (1) {
+        uint64_t largest = 0;
+        uint64_t found = sieve.found;
+        uint64_t covered = sieve_segment(&sieve, &largest);
+        if (covered == 0) {
+            fprintf(stderr, "prime: cannot extend the sieve\n");
+            exit(1);
+        }
+        if (largest > highestPrime) highestPrime = largest;
+        tested += covered;
+        current = sieve.low;
+        progress_add(covered, sieve.found - found, largest);
+        if (checkpoint_due()) saveCheckpoint();
+    }
+}
+
+// Pool search for -t: pre-filter and Miller-Rabin over [from, from + count).
+static uint64_t filterRange(int thread, uint64_t from, uint64_t count, void *arg) {
+    (void)thread;
+    const PrimeKernels *kernels = arg;
+    Prefilter filter;
+    prefilter_init(&filter, from);
+    uint64_t largest = 0, found = 0;
+    for (uint64_t done = 0; done < count; done += 64) {
+        uint64_t base = filter.next;
+        uint64_t alive = kernels->prefilter(&filter);
+        while (alive) {
+            uint64_t x = base + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (miller_rabin_u64(x)) {
+                largest = x;
+                found++;
+            }
+        }
+    }
+    progress_add(count, found, largest);
+    return largest;
+}
+
+// One step of the default search: pre-filter the next 64 candidates, run
+// Miller-Rabin on the survivors and publish the batch.
+static void filterBatch(const PrimeKernels *kernels, Prefilter *filter) {
+    uint64_t base = filter->next;
+    uint64_t alive = kernels->prefilter(filter);
+    uint64_t found = 0;
+    while (alive) {
+        uint64_t x = base + __builtin_ctzll(alive);
+        alive &= alive - 1;
+        if (miller_rabin_u64(x)) {
+            highestPrime = x;
+            found++;
+        }
+    }
+    tested += 64;
+    current = filter->next;
+    progress_add(64, found, highestPrime);
+    if (checkpoint_due()) saveCheckpoint();
+}
+
+// filterBatch() with the best kernels, as the cpu step of --kind mixed.
+static void filterStep(void *arg) {
+    filterBatch(kernels_best(), arg);
+}
+
+// --kind mem, cache, io or mixed: run slices of the workload (for mixed, in
+// turn with slices of the prime search from current). Never returns.
+static void runWorkload(void) {
+    Prefilter filter;
+    prefilter_init(&filter, current);
+    work.cpuStep = filterStep;
+    work.cpuArg = &filter;
+    if (workload_init(&work) < 0) {
+        fprintf(stderr, "prime: cannot set up the %s workload\n", workload_name(work.kind));
+        exit(1);
+    }
+    while (1) workload_slice(&work, workload_next(&work));
+}
+
+// Pool search for -t -w: pre-filter origin + [from, from + count) and test
+// the survivors with Baillie-PSW. Returns the offset of the largest prime
+// (0 if none; origin is even, so offset 0 is never prime).
+static uint64_t wideRange(int thread, uint64_t from, uint64_t count, void *arg) {
+    (void)thread;
+    const PrimeKernels *kernels = arg;
+    Prefilter filter;
+    prefilter_init_u128(&filter, origin + from);
+    uint64_t largest = 0, found = 0;
+    for (uint64_t done = 0; done < count; done += 64) {
+        uint64_t alive = kernels->prefilter(&filter);
+        while (alive) {
+            uint64_t x = from + done + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (bpsw_u128(origin + x)) {
+                largest = x;
+                found++;
+            }
+        }
+    }
+    progress_add(count, found, largest);
+    return largest;
+}
+
+// The main loop above 2^64 (-w): the same pre-filter from origin + current,
+// with Baillie-PSW on the survivors. current and highestPrime stay 64-bit
+// offsets from origin. Never returns.
+static void searchWide(void) {
+    const PrimeKernels *kernels = kernels_best();
+    Prefilter filter;
+    prefilter_init_u128(&filter, origin + current);
+    while (1) {
+        uint64_t alive = kernels->prefilter(&filter);
+        uint64_t found = 0;
+        while (alive) {
+            uint64_t x = current + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (bpsw_u128(origin + x)) {
+                highestPrime = x;
+                found++;
+            }
+        }
+        tested += 64;
+        current += 64;
+        progress_add(64, found, highestPrime);
+        if (checkpoint_due()) saveCheckpoint();
+    }
+}
+
+// Pool search for -t -s: sieve [from, from + count) with the thread's own sieve.
+static uint64_t sieveRange(int thread, uint64_t from, uint64_t count, void *arg) {
+    (void)arg;
+    Sieve *sieve = &threadSieves[thread];
+    sieve_seek(sieve, from);
+    uint64_t largest = 0, found = sieve->found;
+    for (uint64_t done = 0; done < count;) {
+        uint64_t covered = sieve_segment(sieve, &largest);
+        if (covered == 0) {
+            fprintf(stderr, "prime: cannot extend the sieve\n");
+            _exit(1);
+        }
+        done += covered;
+    }
+    progress_add(count, sieve->found - found, largest);
+    return largest;
+}
+
+// Runs the normal handler for a signal taken by sigwait. For SIGTSTP and
+// SIGTERM the pool is parked first so the reported prime, count and
+// checkpoint position are settled and no thread searches while the process
+// is suspended.
+static void threadedSignal(int sig) {
+    if (sig != SIGCONT) {
+        pool_park();
+        current = pool_resume_point();
+    }
+    if (pool_highest() > highestPrime) highestPrime = pool_highest();
+    tested = resumedTested + pool_tested();
+    if (sig == SIGTSTP) handle_tstp(sig);
+    else if (sig == SIGCONT) handle_cont(sig);
+    else handle_term(sig);
+}
+
+// -t N: block all asynchronous signals, search on N pool threads that take
+// fixed-size ranges from work-stealing deques, and handle every signal
+// here with sigwait(). With -c the pool is parked to save a checkpoint
+// CHECKPOINT_SECONDS after the last one, however often signals wake this
+// thread. Never returns.
+static void searchThreads(int threads, int useSieve) {
+    sigset_t blocked;
+    sigfillset(&blocked);
+    sigdelset(&blocked, SIGSEGV);
+    sigdelset(&blocked, SIGBUS);
+    sigdelset(&blocked, SIGFPE);
+    sigdelset(&blocked, SIGILL);
+    pthread_sigmask(SIG_BLOCK, &blocked, NULL);
+
+    sigset_t handled;
+    sigemptyset(&handled);
+    sigaddset(&handled, SIGTSTP);
+    sigaddset(&handled, SIGCONT);
+    sigaddset(&handled, SIGTERM);
+    sigaddset(&handled, SIGINT);
+
+    RangeSearch search = origin ? wideRange : filterRange;
+    void *arg = (void *)kernels_best();
+    uint64_t rangeSize = 1 << 16;
+    if (useSieve) {
+        threadSieves = calloc(threads, sizeof(Sieve));
+        for (int i = 0; threadSieves && i < threads; i++) {
+            if (sieve_init(&threadSieves[i], current, 4ULL * current, 0) < 0) {
+                free(threadSieves);
+                threadSieves = NULL;
+            }
+        }
+        if (!threadSieves) {
+            fprintf(stderr, "prime: cannot allocate the sieves\n");
+            exit(1);
+        }
+        search = sieveRange;
+        rangeSize = 16 * 128 * (uint64_t)threadSieves[0].words; // 16 segments
+    }
+    if (pool_start(threads, current, rangeSize, search, arg) < 0) {
+        fprintf(stderr, "prime: cannot start %d threads\n", threads);
+        exit(1);
+    }
+
+    int running = 1; // 0 between SIGTSTP and SIGCONT, while the pool stays parked
+    while (1) {
+        int sig;
+        if (checkpointing) {
+            struct timespec left;
+            if (!checkpoint_left(&left)) {
+                // Between SIGTSTP and SIGCONT the parked pool's position is already settled.
+                if (running) {
+                    pool_park();
+                    current = pool_resume_point();
+                    if (pool_highest() > highestPrime) highestPrime = pool_highest();
+                    tested = resumedTested + pool_tested();
+                }
+                saveCheckpoint();
+                if (running) pool_resume();
+                continue;
+            }
+            sig = sigtimedwait(&handled, NULL, &left);
+            if (sig < 0) continue;
+        } else if (sigwait(&handled, &sig) != 0) {
+            continue;
+        }
+        threadedSignal(sig);
+        if (sig == SIGTSTP) running = 0;
+        if (sig == SIGCONT) {
+            running = 1;
+            pool_resume();
+        }
+    }
+}
+
 int main(int argc, char **argv) {
-    if (argc < 3) {
-        fprintf(stderr, "prime usage: %s <processNum> <priority>\n", argv[0]);
+    int useSieve = 0;
+    int threads = 0;
+    const char *checkpointDir = NULL;
+    int bad = argc < 3;
+    workload_parse("cpu", &work);
+    for (int i = 3; i < argc && !bad; i++) {
+        if (strcmp(argv[i], "-s") == 0) {
+            useSieve = 1;
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            bad = threads < 1 || threads > POOL_MAX_THREADS;
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            // Publish progress to the scheduler's shared page (fd:slot).
+            if (progress_attach(argv[++i]) < 0) fprintf(stderr, "prime: cannot map progress record %s\n", argv[i]);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            // Keep a checkpoint in dir/<processNum>.ckpt and resume from it.
+            checkpointDir = argv[++i];
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            // Search above 2^64, from 2^bits up, with 128-bit arithmetic.
+            wideBits = (uint32_t)atoi(argv[++i]);
+            bad = wideBits < 64 || wideBits > 127;
+        } else if (strcmp(argv[i], "--kind") == 0 && i + 1 < argc) {
+            // Memory, cache or I/O bound work instead of the prime search, or all four in turn.
+            bad = workload_parse(argv[++i], &work) < 0;
+        } else {
+            bad = 1;
+        }
+    }
+    // -s, -t and -w change how the prime search runs, so they only go with the cpu kind.
+    if (bad || (useSieve && wideBits) || (work.kind != WORK_CPU && (useSieve || threads || wideBits))) {
+        fprintf(stderr, "prime usage: %s <processNum> <priority> [-s | -w 64-127] [-t threads] [-m fd:slot] [-c dir] "
+                "[--kind cpu|mem|cache|io|mixed[:size]]\n", argv[0]);
         return 1;
     }
 
     g_pnum = atoi(argv[1]);
     g_pri  = atoi(argv[2]);
+    if (wideBits) origin = (unsigned __int128)1 << wideBits;
 
-    current = 1234567890ULL + (unsigned long long)g_pnum * 100000ULL;
-
-    // Ensure we have at least one real prime early so prints aren't 0.
-    unsigned long long first = nextPrime(current);
-    highestPrime = first;
-    current = first + 1ULL;
+    // Read the checkpoint before SIGTERM can be handled, so an early
+    // SIGTERM cannot overwrite it with the default starting point.
+    Checkpoint saved;
+    int resuming = 0;
+    if (checkpointDir) {
+        checkpointing = checkpoint_open(checkpointDir, g_pnum) == 0;
+        if (!checkpointing) fprintf(stderr, "prime: checkpoint path too long: %s\n", checkpointDir);
+        resuming = checkpointing && checkpoint_load(&saved);
+    }
+    // A checkpoint from a search with other -w bits or another --kind counts from somewhere else.
+    if (resuming && (saved.wideBits != wideBits || saved.kind != (uint32_t)work.kind)) {
+        fprintf(stderr, "prime: ignoring a checkpoint saved with other -w or --kind options\n");
+        resuming = 0;
+    }
 
+    // Handlers go in first so a signal that arrives right after exec is answered.
     signal(SIGTSTP, handle_tstp);
     signal(SIGCONT, handle_cont);
     signal(SIGTERM, handle_term);
 
+    if (resuming) {
+        current = saved.position;
+        highestPrime = saved.highest;
+        tested = resumedTested = saved.tested;
+        progress_add(0, 0, highestPrime);
+    } else {
+        current = 1234567890ULL + (unsigned long long)g_pnum * 100000ULL;
+
+        // Ensure we have at least one real prime early so prints aren't 0.
+        // The tables behind it are built in (primeTables.h), so this is immediate.
+        unsigned long long first = (unsigned long long)(next_prime_u128(origin + current) - origin);
+        highestPrime = first;
+        current = first + 1ULL;
+        progress_add(0, 1, first);
+    }
+
     printf("Process %d: My priority is %d, my PID is %d: I just got started.\n",
            g_pnum, g_pri, (int)getpid());
-    printf("I am starting with the number %llu to find the next prime number.\n", current);
+    char currentText[U128_DIGITS + 1];
+    u128_to_string(origin + current, currentText);
+    if (resuming) {
+        printf("I am resuming from the number %s (%llu numbers already tested) to find the next prime number.\n",
+               currentText, tested);
+    } else {
+        printf("I am starting with the number %s to find the next prime number.\n", currentText);
+    }
     fflush(stdout);
 
-    while (1) {
-        if (isPrime(current)) {
-            highestPrime = current;
-        }
-        current++;
-    }
+    if (threads > 0) searchThreads(threads, useSieve);
+    if (useSieve) searchSieve();
+    if (wideBits) searchWide();
+    if (work.kind != WORK_CPU) runWorkload();
+
+    // Rule out small factors 64 candidates at a time (SIMD where the CPU has it),
+    // then run Miller-Rabin on the survivors.
+    const PrimeKernels *kernels = kernels_best();
+    Prefilter filter;
+    prefilter_init(&filter, current);
+    while (1) filterBatch(kernels, &filter);
 }
@@ -0,0 +1,410 @@
+// File: primeKernels.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "primeKernels.h"
+#include "primeTables.h"
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+/**************************************************
+Method Name: prefilter_init
+Returns: void
+Input: Prefilter *f, uint64_t start
+Precondition: start > 199, so no candidate is itself one of the small primes
+Task: Copies in the small primes (padding lanes duplicate the prime 3 so
+  they never reject anything the real lane keeps) and sets the residue of
+  start modulo each one.
+ **************************************************/
+void prefilter_init(Prefilter *f, uint64_t start) {
+    memcpy(f->primes, prefilterPrimeTable, sizeof(f->primes));
+    for (int i = 0; i < PREFILTER_LANES; i++) f->residues[i] = (uint32_t)(start % f->primes[i]);
+    f->next = start;
+}
+
+/**************************************************
+Method Name: prefilter_init_u128
+Returns: void
+Input: Prefilter *f, unsigned __int128 start
+Precondition: start > 199
+Task: prefilter_init() for the wide search above 2^64. Only the residues
+  need the full start; the kernels step them the same way, and f->next
+  keeps the low 64 bits, so callers track the 128-bit candidate themselves.
+ **************************************************/
+void prefilter_init_u128(Prefilter *f, unsigned __int128 start) {
+    memcpy(f->primes, prefilterPrimeTable, sizeof(f->primes));
+    for (int i = 0; i < PREFILTER_LANES; i++) f->residues[i] = (uint32_t)(start % f->primes[i]);
+    f->next = (uint64_t)start;
+}
+
+/**************************************************
+Method Name: scalar_supported
+Returns: int
+Input: N/A
+Precondition: N/A
+Task: The scalar kernels run everywhere.
+ **************************************************/
+static int scalar_supported(void) {
+    return 1;
+}
+
+/**************************************************
+Method Name: scalar_prefilter
+Returns: uint64_t
+Input: Prefilter *f
+Precondition: prefilter_init() was called
+Task: Scalar version of the small prime pre-filter for 64 candidates.
+ **************************************************/
+static uint64_t scalar_prefilter(Prefilter *f) {
+    uint64_t alive = 0;
+    for (int c = 0; c < 64; c++) {
+        int divisible = 0;
+        for (int i = 0; i < PREFILTER_PRIMES; i++) {
+            divisible |= f->residues[i] == 0;
+            uint32_t r = f->residues[i] + 1;
+            f->residues[i] = r == f->primes[i] ? 0 : r;
+        }
+        if (!divisible) alive |= 1ULL << c;
+    }
+    for (int i = PREFILTER_PRIMES; i < PREFILTER_LANES; i++) f->residues[i] = f->residues[1];
+    f->next += 64;
+    return alive;
+}
+
+/**************************************************
+Method Name: scalar_or_words
+Returns: void
+Input: uint64_t *dst, const uint64_t *src, size_t n
+Precondition: Both arrays hold n words
+Task: Scalar word-by-word OR.
+ **************************************************/
+static void scalar_or_words(uint64_t *dst, const uint64_t *src, size_t n) {
+    for (size_t i = 0; i < n; i++) dst[i] |= src[i];
+}
+
+/**************************************************
+Method Name: scalar_popcount
+Returns: uint64_t
+Input: const uint64_t *words, size_t n
+Precondition: words holds n words
+Task: Scalar population count.
+ **************************************************/
+static uint64_t scalar_popcount(const uint64_t *words, size_t n) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++) total += __builtin_popcountll(words[i]);
+    return total;
+}
+
+#if defined(__x86_64__)
+
+/**************************************************
+Method Name: avx2_supported
+Returns: int
+Input: N/A
+Precondition: N/A
+Task: Returns 1 if the CPU has AVX2.
+ **************************************************/
+static int avx2_supported(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+/**************************************************
+Method Name: avx2_prefilter
+Returns: uint64_t
+Input: Prefilter *f
+Precondition: The CPU has AVX2
+Task: Small prime pre-filter with eight residues per 256-bit register.
+ **************************************************/
+__attribute__((target("avx2")))
+static uint64_t avx2_prefilter(Prefilter *f) {
+    enum { V = PREFILTER_LANES / 8 };
+    __m256i r[V], p[V];
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    for (int v = 0; v < V; v++) {
+        r[v] = _mm256_load_si256((const __m256i *)(f->residues + 8 * v));
+        p[v] = _mm256_load_si256((const __m256i *)(f->primes + 8 * v));
+    }
+
+    uint64_t alive = 0;
+    for (int c = 0; c < 64; c++) {
+        __m256i hit = zero;
+        for (int v = 0; v < V; v++) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(r[v], zero));
+            r[v] = _mm256_add_epi32(r[v], one);
+            r[v] = _mm256_sub_epi32(r[v], _mm256_and_si256(_mm256_cmpeq_epi32(r[v], p[v]), p[v]));
+        }
+        if (_mm256_testz_si256(hit, hit)) alive |= 1ULL << c;
+    }
+
+    for (int v = 0; v < V; v++) _mm256_store_si256((__m256i *)(f->residues + 8 * v), r[v]);
+    f->next += 64;
+    return alive;
+}
+
+/**************************************************
+Method Name: avx2_or_words
+Returns: void
+Input: uint64_t *dst, const uint64_t *src, size_t n
+Precondition: The CPU has AVX2
+Task: ORs four words per instruction.
+ **************************************************/
+__attribute__((target("avx2")))
+static void avx2_or_words(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(a, b));
+    }
+    for (; i < n; i++) dst[i] |= src[i];
+}
+
+/**************************************************
+Method Name: avx2_popcount
+Returns: uint64_t
+Input: const uint64_t *words, size_t n
+Precondition: The CPU has AVX2
+Task: Counts bits with a 4-bit lookup table (vpshufb) and sums the
+  byte counts with vpsadbw.
+ **************************************************/
+__attribute__((target("avx2")))
+static uint64_t avx2_popcount(const uint64_t *words, size_t n) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(words + i));
+        __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(v, low)),
+                                         _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+    uint64_t total = (uint64_t)_mm256_extract_epi64(sum, 0) + (uint64_t)_mm256_extract_epi64(sum, 1) +
+                     (uint64_t)_mm256_extract_epi64(sum, 2) + (uint64_t)_mm256_extract_epi64(sum, 3);
+    for (; i < n; i++) total += __builtin_popcountll(words[i]);
+    return total;
+}
+
+/**************************************************
+Method Name: avx512_supported
+Returns: int
+Input: N/A
+Precondition: N/A
+Task: Returns 1 if the CPU has AVX-512F and AVX-512BW.
+ **************************************************/
+static int avx512_supported(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+}
+
+/**************************************************
+Method Name: avx512_prefilter
+Returns: uint64_t
+Input: Prefilter *f
+Precondition: The CPU has AVX-512F
+Task: Small prime pre-filter with sixteen residues per 512-bit register,
+  using mask registers for the compare and the conditional wrap.
+ **************************************************/
+__attribute__((target("avx512f")))
+static uint64_t avx512_prefilter(Prefilter *f) {
+    enum { V = PREFILTER_LANES / 16 };
+    __m512i r[V], p[V];
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi32(1);
+    for (int v = 0; v < V; v++) {
+        r[v] = _mm512_load_si512(f->residues + 16 * v);
+        p[v] = _mm512_load_si512(f->primes + 16 * v);
+    }
+
+    uint64_t alive = 0;
+    for (int c = 0; c < 64; c++) {
+        __mmask16 hit = 0;
+        for (int v = 0; v < V; v++) {
+            hit |= _mm512_cmpeq_epi32_mask(r[v], zero);
+            r[v] = _mm512_add_epi32(r[v], one);
+            r[v] = _mm512_mask_sub_epi32(r[v], _mm512_cmpeq_epi32_mask(r[v], p[v]), r[v], p[v]);
+        }
+        if (!hit) alive |= 1ULL << c;
+    }
+
+    for (int v = 0; v < V; v++) _mm512_store_si512(f->residues + 16 * v, r[v]);
+    f->next += 64;
+    return alive;
+}
+
+/**************************************************
+Method Name: avx512_or_words
+Returns: void
+Input: uint64_t *dst, const uint64_t *src, size_t n
+Precondition: The CPU has AVX-512F
+Task: ORs eight words per instruction; the tail uses a masked load/store.
+ **************************************************/
+__attribute__((target("avx512f")))
+static void avx512_or_words(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i a = _mm512_loadu_si512(dst + i);
+        __m512i b = _mm512_loadu_si512(src + i);
+        _mm512_storeu_si512(dst + i, _mm512_or_si512(a, b));
+    }
+    if (i < n) {
+        __mmask8 tail = (__mmask8)((1u << (n - i)) - 1);
+        __m512i a = _mm512_maskz_loadu_epi64(tail, dst + i);
+        __m512i b = _mm512_maskz_loadu_epi64(tail, src + i);
+        _mm512_mask_storeu_epi64(dst + i, tail, _mm512_or_si512(a, b));
+    }
+}
+
+/**************************************************
+Method Name: avx512_popcount
+Returns: uint64_t
+Input: const uint64_t *words, size_t n
+Precondition: The CPU has AVX-512BW
+Task: The AVX2 lookup table method on 512-bit registers (vpshufb and
+  vpsadbw need AVX-512BW; VPOPCNTQ is not assumed).
+ **************************************************/
+__attribute__((target("avx512f,avx512bw")))
+static uint64_t avx512_popcount(const uint64_t *words, size_t n) {
+    const __m512i table = _mm512_set4_epi32(0x04030302, 0x03020201, 0x03020201, 0x02010100);
+    const __m512i low = _mm512_set1_epi8(0x0f);
+    __m512i sum = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i v = _mm512_loadu_si512(words + i);
+        __m512i counts = _mm512_add_epi8(_mm512_shuffle_epi8(table, _mm512_and_si512(v, low)),
+                                         _mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(v, 4), low)));
+        sum = _mm512_add_epi64(sum, _mm512_sad_epu8(counts, _mm512_setzero_si512()));
+    }
+    uint64_t total = (uint64_t)_mm512_reduce_add_epi64(sum);
+    for (; i < n; i++) total += __builtin_popcountll(words[i]);
+    return total;
+}
+
+#elif defined(__aarch64__)
+
+/**************************************************
+Method Name: neon_supported
+Returns: int
+Input: N/A
+Precondition: N/A
+Task: Returns 1 if the kernel reports Advanced SIMD (always true on
+  ordinary ARMv8-A systems, but checked like the x86 features).
+ **************************************************/
+static int neon_supported(void) {
+    return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+}
+
+/**************************************************
+Method Name: neon_prefilter
+Returns: uint64_t
+Input: Prefilter *f
+Precondition: The CPU has Advanced SIMD
+Task: Small prime pre-filter with four residues per 128-bit register.
+ **************************************************/
+static uint64_t neon_prefilter(Prefilter *f) {
+    enum { V = PREFILTER_LANES / 4 };
+    uint32x4_t r[V], p[V];
+    const uint32x4_t zero = vdupq_n_u32(0);
+    const uint32x4_t one = vdupq_n_u32(1);
+    for (int v = 0; v < V; v++) {
+        r[v] = vld1q_u32(f->residues + 4 * v);
+        p[v] = vld1q_u32(f->primes + 4 * v);
+    }
+
+    uint64_t alive = 0;
+    for (int c = 0; c < 64; c++) {
+        uint32x4_t hit = zero;
+        for (int v = 0; v < V; v++) {
+            hit = vorrq_u32(hit, vceqq_u32(r[v], zero));
+            r[v] = vaddq_u32(r[v], one);
+            r[v] = vsubq_u32(r[v], vandq_u32(vceqq_u32(r[v], p[v]), p[v]));
+        }
+        if (vmaxvq_u32(hit) == 0) alive |= 1ULL << c;
+    }
+
+    for (int v = 0; v < V; v++) vst1q_u32(f->residues + 4 * v, r[v]);
+    f->next += 64;
+    return alive;
+}
+
+/**************************************************
+Method Name: neon_or_words
+Returns: void
+Input: uint64_t *dst, const uint64_t *src, size_t n
+Precondition: The CPU has Advanced SIMD
+Task: ORs two words per instruction.
+ **************************************************/
+static void neon_or_words(uint64_t *dst, const uint64_t *src, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) vst1q_u64(dst + i, vorrq_u64(vld1q_u64(dst + i), vld1q_u64(src + i)));
+    for (; i < n; i++) dst[i] |= src[i];
+}
+
+/**************************************************
+Method Name: neon_popcount
+Returns: uint64_t
+Input: const uint64_t *words, size_t n
+Precondition: The CPU has Advanced SIMD
+Task: Counts bits per byte with CNT and sums them with UADDLV.
+ **************************************************/
+static uint64_t neon_popcount(const uint64_t *words, size_t n) {
+    uint64_t total = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) total += vaddlvq_u8(vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + i))));
+    for (; i < n; i++) total += __builtin_popcountll(words[i]);
+    return total;
+}
+
+#endif
+
+// Fastest first; kernels_best() takes the first one the CPU supports.
+static const PrimeKernels variants[] = {
+#if defined(__x86_64__)
+    { "avx512", avx512_supported, avx512_prefilter, avx512_or_words, avx512_popcount },
+    { "avx2", avx2_supported, avx2_prefilter, avx2_or_words, avx2_popcount },
+#elif defined(__aarch64__)
+    { "neon", neon_supported, neon_prefilter, neon_or_words, neon_popcount },
+#endif
+    { "scalar", scalar_supported, scalar_prefilter, scalar_or_words, scalar_popcount },
+};
+
+/**************************************************
+Method Name: kernels_best
+Returns: const PrimeKernels *
+Input: N/A
+Precondition: N/A
+Task: Returns the fastest kernels this CPU supports, detected once.
+ **************************************************/
+const PrimeKernels *kernels_best(void) {
+    static const PrimeKernels *best = NULL;
+    if (!best) {
+        int count = (int)(sizeof(variants) / sizeof(variants[0]));
+        for (int i = 0; i < count && !best; i++) {
+            if (variants[i].supported()) best = &variants[i];
+        }
+    }
+    return best;
+}
+
+/**************************************************
+Method Name: kernels_all
+Returns: const PrimeKernels *
+Input: int *count
+Precondition: N/A
+Task: Returns every variant compiled in for this architecture (check
+  supported() before calling one) and stores how many in *count.
+ **************************************************/
+const PrimeKernels *kernels_all(int *count) {
+    *count = (int)(sizeof(variants) / sizeof(variants[0]));
+    return variants;
+}
@@ -0,0 +1,123 @@
+// File: progress.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _GNU_SOURCE
+
+#include "progress.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static ProgressRecord *records = NULL; // Scheduler: every slot
+static int recordCount = 0;
+static ProgressRecord *mine = NULL;    // Worker: its own slot (scheduler with --fibers: the running job's)
+
+/**************************************************
+Method Name: progress_create
+Returns: int
+Input: int slots
+Precondition: Called by the scheduler before it forks any worker
+Task: Creates a memfd holding one zeroed record per process slot and maps
+  it. The descriptor is left open across exec so workers can attach to
+  it. Returns the descriptor, or -1 on failure.
+ **************************************************/
+int progress_create(int slots) {
+    int fd = memfd_create("scheduler-progress", 0);
+    if (fd < 0) return -1;
+    size_t size = (size_t)slots * sizeof(ProgressRecord);
+    if (ftruncate(fd, (off_t)size) < 0) {
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+    records = map;
+    recordCount = slots;
+    return fd;
+}
+
+/**************************************************
+Method Name: progress_record
+Returns: const ProgressRecord *
+Input: int slot
+Precondition: N/A
+Task: Returns the record of a slot for reading, or NULL if there is no
+  progress page or the slot is out of range.
+ **************************************************/
+const ProgressRecord *progress_record(int slot) {
+    if (!records || slot < 0 || slot >= recordCount) return NULL;
+    return &records[slot];
+}
+
+/**************************************************
+Method Name: progress_attach
+Returns: int
+Input: const char *spec
+Precondition: spec is "fd:slot" as passed by the scheduler
+Task: Maps the page holding this worker's record. Returns 0 on success,
+  -1 if the spec is malformed or the mapping fails.
+ **************************************************/
+int progress_attach(const char *spec) {
+    int fd, slot;
+    if (sscanf(spec, "%d:%d", &fd, &slot) != 2 || fd < 0 || slot < 0) return -1;
+
+    long page = sysconf(_SC_PAGESIZE);
+    off_t offset = (off_t)slot * (off_t)sizeof(ProgressRecord);
+    off_t pageStart = offset - offset % page;
+    void *map = mmap(NULL, (size_t)page, PROT_READ | PROT_WRITE, MAP_SHARED, fd, pageStart);
+    if (map == MAP_FAILED) return -1;
+    mine = (ProgressRecord *)((char *)map + (offset - pageStart));
+    return 0;
+}
+
+/**************************************************
+Method Name: progress_use
+Returns: void
+Input: int slot
+Precondition: progress_create() succeeded, or did not run
+Task: For jobs run inside the scheduler (--fibers): makes slot's record
+  the one progress_add() updates, until the next call. Does nothing
+  without a progress page.
+ **************************************************/
+void progress_use(int slot) {
+    if (records && slot >= 0 && slot < recordCount) mine = &records[slot];
+}
+
+/**************************************************
+Method Name: progress_add
+Returns: void
+Input: uint64_t tested, uint64_t found, uint64_t largest
+Precondition: N/A
+Task: Adds a finished batch of work to this worker's record (safe from
+  several threads at once) and bumps the heartbeat. Does nothing if the
+  worker was not given a record.
+ **************************************************/
+void progress_add(uint64_t tested, uint64_t found, uint64_t largest) {
+    if (!mine) return;
+    atomic_fetch_add_explicit(&mine->tested, tested, memory_order_relaxed);
+    atomic_fetch_add_explicit(&mine->found, found, memory_order_relaxed);
+    uint64_t current = atomic_load_explicit(&mine->highest, memory_order_relaxed);
+    while (largest > current &&
+           !atomic_compare_exchange_weak_explicit(&mine->highest, &current, largest, memory_order_relaxed,
+                                                  memory_order_relaxed)) { }
+    atomic_fetch_add_explicit(&mine->heartbeat, 1, memory_order_relaxed);
+}
+
+/**************************************************
+Method Name: progress_work
+Returns: void
+Input: int counter, uint64_t units
+Precondition: counter is one of PROGRESS_STREAMED, PROGRESS_HOPS, PROGRESS_SYNCS
+Task: Adds a slice of non-prime work (workload.c) to this worker's record
+  and bumps the heartbeat, so hang detection covers every kind.
+ **************************************************/
+void progress_work(int counter, uint64_t units) {
+    if (!mine) return;
+    atomic_fetch_add_explicit(&mine->work[counter], units, memory_order_relaxed);
+    atomic_fetch_add_explicit(&mine->heartbeat, 1, memory_order_relaxed);
+}
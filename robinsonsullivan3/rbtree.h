@@ -0,0 +1,29 @@
+// File: rbtree.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef RBTREE_H
+#define RBTREE_H
+
+// Intrusive red-black tree node. Embed one in the structure being sorted.
+typedef struct RbNode {
+    struct RbNode *left;
+    struct RbNode *right;
+    struct RbNode *parent;
+    int red;                // 1 if red, 0 if black
+    unsigned long long key; // Sort key
+    int id;                 // Owner index, breaks ties between equal keys
+} RbNode;
+
+typedef struct {
+    RbNode *root;
+    RbNode *leftmost;       // Cached smallest node so rb_first() is O(1)
+} RbTree;
+
+void rb_init(RbTree *tree);
+void rb_insert(RbTree *tree, RbNode *node);
+void rb_erase(RbTree *tree, RbNode *node);
+RbNode *rb_first(const RbTree *tree);
+RbNode *rb_next(const RbNode *node);
+
+#endif
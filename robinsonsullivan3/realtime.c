@@ -0,0 +1,205 @@
+// File: realtime.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _GNU_SOURCE
+
+#include "realtime.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define JITTER_BUCKETS 10
+
+// Upper edge (microseconds) of each lateness bucket; the last bucket is open ended.
+static const long bucketEdgeUs[JITTER_BUCKETS - 1] = { 10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000 };
+
+// Tick statistics, updated from the SIGALRM handler (single writer).
+static long long periodNs = 0;
+static long long firstDueNs = 0;   // When tick 1 was due
+static long long lastTickNs = 0;
+static long ticks = 0;
+static long long intervalMin = 0, intervalMax = 0, intervalSum = 0;
+static long long latenessMax = 0, latenessSum = 0;
+static long latenessHist[JITTER_BUCKETS];
+
+static int schedulerCpu = -1;      // CPU the scheduler is pinned to in --rt mode
+
+/**************************************************
+Method Name: now_ns
+Returns: long long
+Input: N/A
+Precondition: N/A
+Task: Returns CLOCK_MONOTONIC in nanoseconds.
+ **************************************************/
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**************************************************
+Method Name: rt_jitter_start
+Returns: void
+Input: long period
+Precondition: Called right after the interval timer is armed with this period
+  (and the same first expiry)
+Task: Resets the tick statistics and remembers when the first tick is due.
+ **************************************************/
+void rt_jitter_start(long period) {
+    periodNs = period;
+    firstDueNs = now_ns() + period;
+    lastTickNs = 0;
+    ticks = 0;
+    intervalMin = intervalMax = intervalSum = 0;
+    latenessMax = latenessSum = 0;
+    memset(latenessHist, 0, sizeof(latenessHist));
+}
+
+/**************************************************
+Method Name: rt_jitter_record
+Returns: void
+Input: N/A
+Precondition: Called first thing in the SIGALRM handler
+Task: Measures the interval since the previous tick and how late this
+  tick is against the ideal schedule firstDue + k * period, and adds the
+  lateness to the histogram. Only does arithmetic and clock_gettime, so
+  it is safe in signal context.
+ **************************************************/
+void rt_jitter_record(void) {
+    if (periodNs == 0) return;
+    long long now = now_ns();
+
+    if (ticks > 0) {
+        long long interval = now - lastTickNs;
+        if (ticks == 1 || interval < intervalMin) intervalMin = interval;
+        if (interval > intervalMax) intervalMax = interval;
+        intervalSum += interval;
+    }
+
+    long long late = now - (firstDueNs + ticks * periodNs);
+    if (late < 0) late = 0; // Fired early (the timer and the clock read are not atomic)
+    if (late > latenessMax) latenessMax = late;
+    latenessSum += late;
+
+    int b = 0;
+    while (b < JITTER_BUCKETS - 1 && late >= bucketEdgeUs[b] * 1000LL) b++;
+    latenessHist[b]++;
+
+    lastTickNs = now;
+    ticks++;
+}
+
+/**************************************************
+Method Name: rt_jitter_stats
+Returns: void
+Input: long *tickCount, long long *maxNs, long long *sumNs
+Precondition: Not called from inside the timer handler while it records
+Task: Returns the number of ticks measured so far with the worst and the
+  total tick lateness, so callers can sample lateness over a window.
+ **************************************************/
+void rt_jitter_stats(long *tickCount, long long *maxNs, long long *sumNs) {
+    *tickCount = ticks;
+    *maxNs = latenessMax;
+    *sumNs = latenessSum;
+}
+
+/**************************************************
+Method Name: rt_jitter_report
+Returns: void
+Input: FILE *out
+Precondition: rt_jitter_start() was called
+Task: Prints the tick interval range and a histogram of tick lateness.
+ **************************************************/
+void rt_jitter_report(FILE *out) {
+    if (ticks == 0) return;
+
+    fprintf(out, "Tick jitter over %ld ticks (period %.3f ms):\n", ticks, periodNs / 1e6);
+    if (ticks > 1) {
+        fprintf(out, "  interval min %.3f ms, avg %.3f ms, max %.3f ms\n",
+                intervalMin / 1e6, intervalSum / 1e6 / (ticks - 1), intervalMax / 1e6);
+    }
+    fprintf(out, "  lateness avg %.1f us, max %.1f us\n", latenessSum / 1e3 / ticks, latenessMax / 1e3);
+
+    for (int b = 0; b < JITTER_BUCKETS; b++) {
+        if (latenessHist[b] == 0) continue;
+        char label[32];
+        if (b == 0) snprintf(label, sizeof(label), "< %ld us", bucketEdgeUs[0]);
+        else if (b == JITTER_BUCKETS - 1) snprintf(label, sizeof(label), ">= %ld us", bucketEdgeUs[b - 1]);
+        else snprintf(label, sizeof(label), "%ld-%ld us", bucketEdgeUs[b - 1], bucketEdgeUs[b]);
+
+        int bar = (int)(40 * latenessHist[b] / ticks);
+        fprintf(out, "  %-14s %6ld %.*s\n", label, latenessHist[b], bar > 0 ? bar : 1,
+                "########################################");
+    }
+}
+
+/**************************************************
+Method Name: rt_harden
+Returns: int
+Input: N/A
+Precondition: Called once in the scheduler before any child is forked
+Task: Locks the scheduler's memory (mlockall), switches it to SCHED_FIFO
+  with SCHED_RESET_ON_FORK so children go back to normal scheduling, and
+  pins it to the last CPU so rt_isolate_worker() can keep workers off it.
+  Each step that fails (usually EPERM without CAP_SYS_NICE) prints a
+  warning and the rest still run. Returns the number of steps that failed.
+ **************************************************/
+int rt_harden(void) {
+    int failed = 0;
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        fprintf(stderr, "rt: mlockall failed: %s\n", strerror(errno));
+        failed++;
+    }
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+    if (sched_setscheduler(0, SCHED_FIFO | SCHED_RESET_ON_FORK, &param) != 0) {
+        fprintf(stderr, "rt: SCHED_FIFO failed: %s\n", strerror(errno));
+        failed++;
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 2) {
+        fprintf(stderr, "rt: only %ld CPU online, cannot isolate the scheduler from the workers\n", cpus);
+        failed++;
+    } else {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET((int)cpus - 1, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            fprintf(stderr, "rt: pinning to CPU %ld failed: %s\n", cpus - 1, strerror(errno));
+            failed++;
+        } else {
+            schedulerCpu = (int)cpus - 1;
+        }
+    }
+
+    return failed;
+}
+
+/**************************************************
+Method Name: rt_isolate_worker
+Returns: void
+Input: N/A
+Precondition: Called in a freshly forked child before exec
+Task: If the scheduler was pinned by rt_harden(), moves the worker onto
+  every other online CPU so it never competes with the scheduler.
+ **************************************************/
+void rt_isolate_worker(void) {
+    if (schedulerCpu < 0) return;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c = 0; c < cpus && c < CPU_SETSIZE; c++) {
+        if (c != schedulerCpu) CPU_SET(c, &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+}
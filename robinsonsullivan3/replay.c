@@ -0,0 +1,289 @@
+// File: replay.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "replay.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_REPLAY_RECORDS 262144
+#define MIN_LATENCY_SAMPLES 100 // Fewer selections than this are too noisy to call a regression
+
+enum { MODE_OFF, MODE_RECORD, MODE_CHECK };
+
+// Records are kept in memory so recording never does I/O from the timer signal.
+static int mode = MODE_OFF;
+static const char *recordPath = NULL;
+static ReplayRecord *records = NULL; // Recorded log (record mode) or loaded log (check mode)
+static long nRecords = 0;            // Records in the buffer
+static long position = 0;            // Next record to compare in check mode
+static long overflow = 0;            // Records (record mode) or latencies (check mode) that did not fit
+
+// Check mode results
+static long mismatchAt = -1;         // Index of the first diverging record, -1 if none
+static ReplayRecord expected, actual;
+static uint64_t *newLatency = NULL;  // Selection latencies measured by this build
+static long nNewLatency = 0;
+
+/**************************************************
+Method Name: replay_clock_ns
+Returns: uint64_t
+Input: N/A
+Precondition: N/A
+Task: Returns CLOCK_MONOTONIC in nanoseconds, used to time the
+  selection path.
+ **************************************************/
+uint64_t replay_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**************************************************
+Method Name: replay_record_open
+Returns: int
+Input: const char *path
+Precondition: Called once before the first tick
+Task: Starts recording. The log is written to path by replay_finish().
+  Returns 0 on success, -1 if the buffer cannot be allocated.
+ **************************************************/
+int replay_record_open(const char *path) {
+    records = malloc(sizeof(ReplayRecord) * MAX_REPLAY_RECORDS);
+    if (!records) return -1;
+    recordPath = path;
+    mode = MODE_RECORD;
+    return 0;
+}
+
+/**************************************************
+Method Name: replay_check_open
+Returns: int
+Input: const char *path
+Precondition: Called once before the first tick
+Task: Loads a recorded log so this run's decisions can be checked
+  against it. Returns 0 on success, -1 if the log cannot be read.
+ **************************************************/
+int replay_check_open(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror("fopen replay log");
+        return -1;
+    }
+
+    char magic[4];
+    uint32_t recordSize;
+    if (fread(magic, 1, 4, f) != 4 || memcmp(magic, REPLAY_MAGIC, 4) != 0 ||
+        fread(&recordSize, sizeof(recordSize), 1, f) != 1 || recordSize != sizeof(ReplayRecord)) {
+        fprintf(stderr, "%s is not a replay log from this build\n", path);
+        fclose(f);
+        return -1;
+    }
+
+    records = malloc(sizeof(ReplayRecord) * MAX_REPLAY_RECORDS);
+    newLatency = malloc(sizeof(uint64_t) * MAX_REPLAY_RECORDS);
+    if (!records || !newLatency) {
+        fclose(f);
+        return -1;
+    }
+    nRecords = (long)fread(records, sizeof(ReplayRecord), MAX_REPLAY_RECORDS, f);
+    fclose(f);
+
+    mode = MODE_CHECK;
+    return 0;
+}
+
+/**************************************************
+Method Name: replay_active
+Returns: int
+Input: N/A
+Precondition: N/A
+Task: Returns 1 if recording or checking is on.
+ **************************************************/
+int replay_active(void) {
+    return mode != MODE_OFF;
+}
+
+/**************************************************
+Method Name: replay_add
+Returns: void
+Input: int type, int tick, int procNum, int value, uint64_t latencyNs
+Precondition: N/A
+Task: Appends a record (record mode) or compares it with the next one in
+  the loaded log (check mode). Only the first divergence is kept. The
+  latency is not part of the comparison, it is collected separately.
+ **************************************************/
+static void replay_add(int type, int tick, int procNum, int value, uint64_t latencyNs) {
+    ReplayRecord r;
+    r.tick = tick;
+    r.type = (uint16_t)type;
+    r.pad = 0;
+    r.procNum = procNum;
+    r.value = value;
+    r.latencyNs = latencyNs;
+
+    if (mode == MODE_RECORD) {
+        if (nRecords < MAX_REPLAY_RECORDS) records[nRecords++] = r;
+        else overflow++;
+        return;
+    }
+    if (mode != MODE_CHECK) return;
+
+    if (type == RP_SELECT) {
+        if (nNewLatency < MAX_REPLAY_RECORDS) newLatency[nNewLatency++] = latencyNs;
+        else overflow++;
+    }
+    if (mismatchAt >= 0) return;
+
+    if (position >= nRecords) {
+        mismatchAt = position;
+        memset(&expected, 0, sizeof(expected));
+        actual = r;
+        return;
+    }
+
+    ReplayRecord *e = &records[position];
+    if (e->tick != r.tick || e->type != r.type || e->procNum != r.procNum || e->value != r.value) {
+        mismatchAt = position;
+        expected = *e;
+        actual = r;
+    }
+    position++;
+}
+
+/**************************************************
+Method Name: replay_arrival
+Returns: void
+Input: int tick, int procNum
+Precondition: N/A
+Task: Logs that procNum arrived at tick.
+ **************************************************/
+void replay_arrival(int tick, int procNum) {
+    replay_add(RP_ARRIVAL, tick, procNum, 0, 0);
+}
+
+/**************************************************
+Method Name: replay_tick
+Returns: void
+Input: int tick, int procNum, int remaining
+Precondition: N/A
+Task: Logs that the tick was charged to procNum (-1 if the CPU was idle).
+ **************************************************/
+void replay_tick(int tick, int procNum, int remaining) {
+    replay_add(RP_TICK, tick, procNum, remaining, 0);
+}
+
+/**************************************************
+Method Name: replay_select
+Returns: void
+Input: int tick, int prevProcNum, int procNum, uint64_t latencyNs
+Precondition: N/A
+Task: Logs a selection decision and how long the selection path took.
+ **************************************************/
+void replay_select(int tick, int prevProcNum, int procNum, uint64_t latencyNs) {
+    replay_add(RP_SELECT, tick, procNum, prevProcNum, latencyNs);
+}
+
+/**************************************************
+Method Name: compare_u64
+Returns: int
+Input: const void *a, const void *b
+Precondition: a and b point to uint64_t values
+Task: qsort comparator for latencies.
+ **************************************************/
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**************************************************
+Method Name: percentile
+Returns: uint64_t
+Input: uint64_t *values, long n, double pct
+Precondition: values is sorted, n > 0
+Task: Returns the pct percentile of values.
+ **************************************************/
+static uint64_t percentile(uint64_t *values, long n, double pct) {
+    long idx = (long)(pct / 100.0 * (double)(n - 1) + 0.5);
+    return values[idx];
+}
+
+/**************************************************
+Method Name: replay_finish
+Returns: int
+Input: FILE *out, double tolerancePct
+Precondition: The run is over
+Task: In record mode writes the log. In check mode reports whether every
+  decision matched the recording and compares selection latency (median
+  and p99). Returns 0 if all is well, 1 if the decisions diverged, 2 if
+  the log could not be written, and 3 if the median selection latency
+  grew by more than tolerancePct over at least MIN_LATENCY_SAMPLES selections.
+ **************************************************/
+int replay_finish(FILE *out, double tolerancePct) {
+    if (mode == MODE_RECORD) {
+        FILE *f = fopen(recordPath, "wb");
+        if (!f) {
+            perror("fopen replay log");
+            return 2;
+        }
+        uint32_t recordSize = sizeof(ReplayRecord);
+        fwrite(REPLAY_MAGIC, 1, 4, f);
+        fwrite(&recordSize, sizeof(recordSize), 1, f);
+        fwrite(records, sizeof(ReplayRecord), (size_t)nRecords, f);
+        fclose(f);
+        fprintf(out, "Recorded %ld events to %s\n", nRecords, recordPath);
+        if (overflow > 0) {
+            fprintf(out, "Replay log full, %ld events not recorded\n", overflow);
+            return 2;
+        }
+        return 0;
+    }
+    if (mode != MODE_CHECK) return 0;
+
+    if (mismatchAt < 0 && position < nRecords) {
+        mismatchAt = position;
+        expected = records[position];
+        memset(&actual, 0, sizeof(actual));
+    }
+
+    int status = 0;
+    if (mismatchAt >= 0) {
+        fprintf(out, "REPLAY MISMATCH at record %ld: expected type=%d t=%d p=%d value=%d, got type=%d t=%d p=%d value=%d\n",
+                mismatchAt, expected.type, expected.tick, expected.procNum, expected.value,
+                actual.type, actual.tick, actual.procNum, actual.value);
+        status = 1;
+    } else {
+        fprintf(out, "Replay OK: %ld events matched\n", nRecords);
+    }
+    if (overflow > 0) {
+        fprintf(out, "Latency buffer full, %ld selections not timed\n", overflow);
+    }
+
+    // Selection latency: recorded build vs this build.
+    uint64_t *old = malloc(sizeof(uint64_t) * (size_t)(nRecords > 0 ? nRecords : 1));
+    long nOld = 0;
+    for (long i = 0; old && i < nRecords; i++) {
+        if (records[i].type == RP_SELECT) old[nOld++] = records[i].latencyNs;
+    }
+    if (old && nOld > 0 && nNewLatency > 0) {
+        qsort(old, (size_t)nOld, sizeof(uint64_t), compare_u64);
+        qsort(newLatency, (size_t)nNewLatency, sizeof(uint64_t), compare_u64);
+        uint64_t oldMed = percentile(old, nOld, 50), newMed = percentile(newLatency, nNewLatency, 50);
+        uint64_t oldP99 = percentile(old, nOld, 99), newP99 = percentile(newLatency, nNewLatency, 99);
+        double change = oldMed > 0 ? 100.0 * ((double)newMed - (double)oldMed) / (double)oldMed : 0.0;
+
+        fprintf(out, "Selection latency: median %llu ns vs %llu ns recorded (%+.1f%%), p99 %llu ns vs %llu ns\n",
+                (unsigned long long)newMed, (unsigned long long)oldMed, change,
+                (unsigned long long)newP99, (unsigned long long)oldP99);
+        if (nOld < MIN_LATENCY_SAMPLES || nNewLatency < MIN_LATENCY_SAMPLES) {
+            fprintf(out, "Too few selections (%ld recorded, %ld now) to judge selection latency\n", nOld, nNewLatency);
+        } else if (status == 0 && change > tolerancePct) {
+            fprintf(out, "REPLAY REGRESSION: median selection latency grew more than %.1f%%\n", tolerancePct);
+            status = 3;
+        }
+    }
+    free(old);
+    return status;
+}
@@ -0,0 +1,39 @@
+// File: replay.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Record types in a replay log
+enum {
+    RP_ARRIVAL = 1, // procNum arrived at tick
+    RP_TICK,        // Tick charged to procNum (value = its remaining time after the charge)
+    RP_SELECT       // Selection at tick: value = previous procNum, procNum = chosen (-1 = idle)
+};
+
+// One replay log record (24 bytes, written to disk as is)
+typedef struct {
+    int32_t tick;
+    uint16_t type;      // RP_* type
+    uint16_t pad;
+    int32_t procNum;
+    int32_t value;
+    uint64_t latencyNs; // Selection path latency for RP_SELECT, 0 otherwise
+} ReplayRecord;
+
+#define REPLAY_MAGIC "RPL1" // First 4 bytes of a replay log, followed by uint32 record size
+
+int replay_record_open(const char *path);
+int replay_check_open(const char *path);
+int replay_active(void);
+uint64_t replay_clock_ns(void);
+void replay_arrival(int tick, int procNum);
+void replay_tick(int tick, int procNum, int remaining);
+void replay_select(int tick, int prevProcNum, int procNum, uint64_t latencyNs);
+int replay_finish(FILE *out, double tolerancePct);
+
+#endif
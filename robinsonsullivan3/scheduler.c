@@ -10,6 +10,22 @@
 #include <signal.h>
 #include <sys/time.h>
 #include <unistd.h>
+#include <getopt.h>
+
+#include "fairShare.h"
+#include "trace.h"
+#include "realtime.h"
+#include "replay.h"
+#include "control.h"
+#include "sweep.h"
+#include "progress.h"
+#include "fiber.h"
+#include "primality.h"
+#include "primeKernels.h"
+
+#define MAX_PROCS 16384
+#define MAX_LEVELS 8
+#define HANG_TICKS 3 // Running ticks without a heartbeat before a worker is reported as hung
 
 typedef struct {
     int processNum;
@@ -20,51 +36,303 @@ typedef struct {
     int started;
     int finished;
     pid_t pid;
+    int level;       // MLFQ queue level (0 is the highest)
+    int quantumUsed; // Ticks used at the current level
+    int seq;         // Round-robin order within a level (smaller runs first)
+    int waitTime;    // Total ticks spent ready but not running
+    int agedWait;    // Ticks waited since last run or promotion (for aging)
+    int finishTime;  // Tick the process finished
+    FairEntity fair; // Fair share state (vruntime, weight, CPU share)
+    uint64_t lastTested;    // Progress record: candidates tested at the last running tick
+    uint64_t lastHeartbeat; // Progress record: heartbeat at the last running tick
+    int stalledTicks;       // Running ticks in a row without a heartbeat
 } PCB;
 
-static PCB procs[10];
-static int n = 0;
+// Scheduling policy options. MLFQ is on when mlfqLevels > 0, fair share when fairShare is set,
+// otherwise plain preemptive priority.
+typedef struct {
+    int mlfqLevels;
+    int quanta[MAX_LEVELS];
+    int boostPeriod;    // Move every job to level 0 every N ticks (0 = off)
+    int agingLimit;     // Promote a job one level after N ticks of waiting (0 = off)
+    int fairShare;      // Order runnable processes by weighted virtual runtime
+    int minGranularity; // Fair share: ticks a process runs before it can be preempted
+} Policy;
+
+// State of one scheduler run. The timer and -s drive a single instance (live),
+// while a sweep runs one instance per configuration x trace on worker threads.
+typedef struct {
+    Policy policy;
+    PCB *procs;
+    int n;
+    int cap;            // Entries available in procs[]
+    volatile sig_atomic_t currentTime;
+    int running;        // Index of the running process, -1 if the CPU is idle
+    int nextSeq;
+    int nextProcessNum; // Number given to the next job submitted over the control socket
+    FairQueue fairQueue;
+    int quiet;          // Sweep runs print nothing
+    int dispatches;     // Times the CPU went to a different process
+} Scheduler;
+
+static PCB liveProcs[MAX_PROCS];
+static Scheduler live;
+
+// Simulated mode runs on a virtual clock without forking children
+static int simulate = 0;
+
+// --sieve has the children search with a segmented sieve (./prime pnum priority -s),
+// --worker-threads N runs each child with N search threads (./prime pnum priority -t N)
+static int workerSieve = 0;
+static const char *workerThreads = NULL;
+
+// Workers publish progress to a shared memfd page (./prime ... -m fd:slot) that the
+// scheduler reads every tick, --progress prints the running job's rate each tick
+static int progressFd = -1;
+static int showProgress = 0;
+
+// --checkpoint dir has every child keep a checkpoint there and resume from it (./prime ... -c dir)
+static const char *checkpointDir = NULL;
 
-static volatile sig_atomic_t currentTime = 0;
-static int running = -1;
+// --wide BITS has every child search from 2^BITS with 128-bit arithmetic (./prime ... -w BITS)
+static const char *wideBits = NULL;
+
+// --kind KIND[:size] has every child run a memory, cache or I/O bound workload, or a mix (./prime ... --kind KIND)
+static const char *workKind = NULL;
+
+// --fibers runs every job's prime search as a coroutine inside the scheduler instead of
+// forking ./prime; the tick preempts it at the search's batch boundaries
+typedef struct {
+    Fiber fiber;
+    uint64_t current; // Next candidate to test
+    uint64_t highest; // Highest prime found so far
+    uint64_t tested;  // Candidates tested
+    long long runNs;  // Wall time the job ran (it has the CPU to itself)
+    long long runStart; // When its current run began, 0 while switched out
+    int ran;          // Has run at least once, so SIGCONT is a resume
+    int ended;        // Terminated; its stack is freed once it is switched out
+} FiberJob;
+static int useFibers = 0;
+static FiberJob *fiberJobs = NULL;  // One per process slot
+static double fiberSwitchNs = 0.0;  // Measured before the run: resume + yield of a fiber
+static double fiberStopNs = 0.0;    // and SIGSTOP + SIGCONT of a process
+
+// Timeline output (--trace / --gantt)
+static const char *tracePath = NULL;
+static int gantt = 0;
+
+// --rt locks memory, runs the scheduler at SCHED_FIFO and keeps children off its CPU
+static int realTime = 0;
+
+// --record / --replay log every arrival, tick and selection for regression checks
+static const char *recordPath = NULL;
+static const char *replayPath = NULL;
+static double tolerance = 25.0; // Allowed growth in median selection latency (percent)
+
+// -c path opens a control socket for submitting, reprioritizing and cancelling jobs at run time
+static const char *controlPath = NULL;
+static volatile sig_atomic_t shutdownRequested = 0;
+
+// --sweep grid.txt runs every grid configuration against every input file on a thread pool
+static const char *sweepPath = NULL;
+static const char *csvPath = NULL;
+static int sweepThreads = 0;
 
 /**************************************************
 Method Name: fork_and_exec
 Returns: void
-Input: int idx
+Input: Scheduler *s, int idx
 Precondition: idx is a valid index in procs[]
 Task: Forks a child process and execs ./prime with args:
-      <processNum> <priority>, then stores the child's PID.
+      <processNum> <priority> [-s] [-t threads] [-m fd:slot] [-c dir], then
+      stores the child's PID.
  **************************************************/
-static void fork_and_exec(int idx) {
+static void fork_and_exec(Scheduler *s, int idx) {
     pid_t pid = fork();
     if (pid < 0) {
         perror("fork");
         exit(1);
     }
     if (pid == 0) {
+        rt_isolate_worker();
+
         char pnum[16], pri[16];
-        snprintf(pnum, sizeof(pnum), "%d", procs[idx].processNum);
-        snprintf(pri, sizeof(pri), "%d", procs[idx].priority);
+        snprintf(pnum, sizeof(pnum), "%d", s->procs[idx].processNum);
+        snprintf(pri, sizeof(pri), "%d", s->procs[idx].priority);
 
-        execl("./prime", "prime", pnum, pri, (char *)NULL);
-        perror("execl");
+        char *args[15], progressSpec[32];
+        int n = 0;
+        args[n++] = "prime";
+        args[n++] = pnum;
+        args[n++] = pri;
+        if (workerSieve) args[n++] = "-s";
+        if (wideBits) {
+            args[n++] = "-w";
+            args[n++] = (char *)wideBits;
+        }
+        if (workKind) {
+            args[n++] = "--kind";
+            args[n++] = (char *)workKind;
+        }
+        if (workerThreads) {
+            args[n++] = "-t";
+            args[n++] = (char *)workerThreads;
+        }
+        if (progressFd >= 0) {
+            snprintf(progressSpec, sizeof(progressSpec), "%d:%d", progressFd, idx);
+            args[n++] = "-m";
+            args[n++] = progressSpec;
+        }
+        if (checkpointDir) {
+            args[n++] = "-c";
+            args[n++] = (char *)checkpointDir;
+        }
+        args[n] = NULL;
+        execv("./prime", args);
+        perror("execv");
         _exit(1);
     }
 
-    procs[idx].pid = pid;
+    s->procs[idx].pid = pid;
+}
+
+/**************************************************
+Method Name: fiber_job
+Returns: void
+Input: void *arg
+Precondition: arg is the job's FiberJob; runs on its fiber with its
+  progress record selected
+Task: The prime search of ./prime run in the scheduler (--fibers): starts
+  at the same number, rules out small factors 64 candidates at a time and
+  runs Miller-Rabin on the survivors. After each batch (the safe point)
+  it yields if the tick asked for the CPU. Never returns.
+ **************************************************/
+static void fiber_job(void *arg) {
+    FiberJob *job = arg;
+    PCB *p = &live.procs[job - fiberJobs];
+    job->current = 1234567890ULL + (uint64_t)p->processNum * 100000ULL;
+    job->highest = next_prime_u64(job->current);
+    job->current = job->highest + 1;
+    progress_add(0, 1, job->highest);
+    printf("Process %d: My priority is %d, I am a fiber in the scheduler: I just got started.\n", p->processNum, p->priority);
+    printf("I am starting with the number %llu to find the next prime number.\n", (unsigned long long)job->current);
+    fflush(stdout);
+
+    const PrimeKernels *kernels = kernels_best();
+    Prefilter filter;
+    prefilter_init(&filter, job->current);
+    while (1) {
+        uint64_t base = filter.next;
+        uint64_t alive = kernels->prefilter(&filter);
+        uint64_t found = 0;
+        while (alive) {
+            uint64_t x = base + __builtin_ctzll(alive);
+            alive &= alive - 1;
+            if (miller_rabin_u64(x)) {
+                job->highest = x;
+                found++;
+            }
+        }
+        job->tested += 64;
+        job->current = filter.next;
+        progress_add(64, found, job->highest);
+        if (fiberPreempt) fiber_yield();
+    }
+}
+
+/**************************************************
+Method Name: job_run_ns
+Returns: long long
+Input: const FiberJob *job
+Precondition: N/A
+Task: Nanoseconds the job has run, including its current run if it is
+  the fiber the tick interrupted.
+ **************************************************/
+static long long job_run_ns(const FiberJob *job) {
+    return job->runNs + (job->runStart ? (long long)replay_clock_ns() - job->runStart : 0);
+}
+
+/**************************************************
+Method Name: signal_fiber
+Returns: void
+Input: Scheduler *s, int idx, int sig
+Precondition: --fibers; procs[idx] has been started
+Task: What the signals do to a ./prime child, for a fiber job. Prints the
+  worker's message; SIGTERM also ends the job. The switch itself happens
+  when the running fiber reaches its next safe point.
+ **************************************************/
+static void signal_fiber(Scheduler *s, int idx, int sig) {
+    FiberJob *job = &fiberJobs[idx];
+    PCB *p = &s->procs[idx];
+    if (sig == SIGTSTP) {
+        printf("Process %d: My priority is %d, I am a fiber in the scheduler: I am about to be suspended... "
+               "Highest prime number I found is %llu.\n", p->processNum, p->priority, (unsigned long long)job->highest);
+    } else if (sig == SIGCONT && job->ran) {
+        printf("Process %d: My priority is %d, I am a fiber in the scheduler: I just got resumed. "
+               "Highest prime number I found is %llu.\n", p->processNum, p->priority, (unsigned long long)job->highest);
+    } else if (sig == SIGTERM) {
+        long long runNs = job_run_ns(job);
+        printf("Process %d: My priority is %d, I am a fiber in the scheduler: I completed my task and I am exiting. "
+               "Highest prime number I found is %llu. I tested %llu numbers (%.0f per second).\n",
+               p->processNum, p->priority, (unsigned long long)job->highest, (unsigned long long)job->tested,
+               runNs > 0 ? job->tested * 1e9 / runNs : 0.0);
+        job->ended = 1;
+    }
+    fflush(stdout);
+}
+
+/**************************************************
+Method Name: send_signal
+Returns: void
+Input: Scheduler *s, int idx, int sig
+Precondition: idx is a valid index in procs[]
+Task: Sends sig to the child for procs[idx]. Does nothing in simulated
+      mode, where no children exist, and with --fibers acts it out on
+      the job's fiber instead.
+ **************************************************/
+static void send_signal(Scheduler *s, int idx, int sig) {
+    if (simulate) return;
+    if (useFibers) {
+        signal_fiber(s, idx, sig);
+        return;
+    }
+    kill(s->procs[idx].pid, sig);
+}
+
+/**************************************************
+Method Name: start_process
+Returns: void
+Input: Scheduler *s, int idx
+Precondition: idx is a valid index in procs[] and has not started
+Task: Forks the child (or fakes a PID in simulated mode, or with --fibers
+      sets up the job's fiber, which runs under the scheduler's PID) and
+      marks the process as started.
+ **************************************************/
+static void start_process(Scheduler *s, int idx) {
+    if (simulate) {
+        s->procs[idx].pid = 0;
+    } else if (useFibers) {
+        if (fiber_init(&fiberJobs[idx].fiber, fiber_job, &fiberJobs[idx]) < 0) {
+            perror("Fiber stack");
+            exit(1);
+        }
+        s->procs[idx].pid = getpid();
+    } else {
+        fork_and_exec(s, idx);
+    }
+    s->procs[idx].started = 1;
 }
 
 /**************************************************
 Method Name: all_finished
 Returns: int
-Input: N/A
+Input: Scheduler *s
 Precondition: procs[] has been populated, n > 0
 Task: Returns 1 if all processes are finished, otherwise 0.
  **************************************************/
-static int all_finished(void) {
-    for (int i = 0; i < n; i++) {
-        if (!procs[i].finished) return 0;
+static int all_finished(Scheduler *s) {
+    for (int i = 0; i < s->n; i++) {
+        if (!s->procs[i].finished) return 0;
     }
     return 1;
 }
@@ -72,23 +340,32 @@ static int all_finished(void) {
 /**************************************************
 Method Name: pick_next_ready
 Returns: int
-Input: N/A
+Input: Scheduler *s
 Precondition: currentTime reflects the scheduler's time in seconds
-Task: Chooses the next ready process based on preemptive priority
+Task: Chooses the next ready process based on preemptive priority.
+  In MLFQ mode the highest non-empty level wins, and processes in
+  the same level take turns in round-robin order.
  **************************************************/
-static int pick_next_ready(void) {
+static int pick_next_ready(Scheduler *s) {
     int next = -1;
-    int bestPri = 1 << 30;
 
-    for (int i = 0; i < n; i++) {
-        if (procs[i].finished) continue;
-        if (procs[i].arrival > (int)currentTime) continue;
-        if (procs[i].remaining <= 0) continue;
+    for (int i = 0; i < s->n; i++) {
+        if (s->procs[i].finished) continue;
+        if (s->procs[i].arrival > (int)s->currentTime) continue;
+        if (s->procs[i].remaining <= 0) continue;
 
-        if (next == -1 ||
-            procs[i].priority < procs[next].priority ||
-            (procs[i].priority == procs[next].priority &&
-             procs[i].arrival < procs[next].arrival))
+        if (next == -1) {
+            next = i;
+        } else if (s->policy.mlfqLevels > 0) {
+            if (s->procs[i].level < s->procs[next].level ||
+                (s->procs[i].level == s->procs[next].level &&
+                 s->procs[i].seq < s->procs[next].seq))
+            {
+                next = i;
+            }
+        } else if (s->procs[i].priority < s->procs[next].priority ||
+                   (s->procs[i].priority == s->procs[next].priority &&
+                    s->procs[i].arrival < s->procs[next].arrival))
         {
             next = i;
         }
@@ -97,81 +374,418 @@ static int pick_next_ready(void) {
 }
 
 /**************************************************
-Method Name: schedule_one_tick
+Method Name: account_waiting
 Returns: void
-Input: N/A
-Precondition: Called once per second (timer tick)
-Task: Decrements remaining time for the currently running process.
-  If it reaches 0, terminate it and mark finished. If all processes 
-  finished, exit scheduler. Picks the best ready process by priority.
-  If needed, preempts current process (SIGTSTP) and starts/resumes 
-  the selected one (fork/exec or SIGCONT).
- **************************************************/
-static void schedule_one_tick(void) {
-    if (running != -1) {
-        if (procs[running].remaining > 0) {
-            procs[running].remaining--;
+Input: Scheduler *s
+Precondition: Called once per tick before the running process changes
+Task: Charges one tick of waiting time to every process that was ready
+  during the last tick but did not get the CPU. In MLFQ mode this also
+  ages processes that have waited too long by promoting them one level.
+ **************************************************/
+static void account_waiting(Scheduler *s) {
+    for (int i = 0; i < s->n; i++) {
+        if (i == s->running || s->procs[i].finished) continue;
+        if (s->procs[i].arrival > (int)s->currentTime - 1) continue;
+
+        s->procs[i].waitTime++;
+        s->procs[i].agedWait++;
+
+        if (s->policy.mlfqLevels > 0 && s->policy.agingLimit > 0 &&
+            s->procs[i].agedWait >= s->policy.agingLimit && s->procs[i].level > 0)
+        {
+            s->procs[i].level--;
+            s->procs[i].quantumUsed = 0;
+            s->procs[i].agedWait = 0;
         }
-        if (procs[running].remaining == 0 && !procs[running].finished) {
-            printf("\nScheduler: Time Now: %d seconds\n", (int)currentTime);
-            printf("Terminating Process %d (Pid %d)\n", procs[running].processNum, (int)procs[running].pid);
+    }
+}
+
+/**************************************************
+Method Name: mlfq_tick
+Returns: void
+Input: Scheduler *s
+Precondition: MLFQ mode is on and the running process was just charged
+  one tick
+Task: Demotes the running process when it has used its whole quantum
+  and sends it to the back of its new level. Every boostPeriod ticks
+  all processes are moved back to level 0.
+ **************************************************/
+static void mlfq_tick(Scheduler *s) {
+    if (s->running != -1 && !s->procs[s->running].finished) {
+        PCB *p = &s->procs[s->running];
+        p->agedWait = 0;
+        p->quantumUsed++;
+        if (p->quantumUsed >= s->policy.quanta[p->level]) {
+            if (p->level < s->policy.mlfqLevels - 1) p->level++;
+            p->quantumUsed = 0;
+            p->seq = s->nextSeq++;
+        }
+    }
+
+    if (s->policy.boostPeriod > 0 && (int)s->currentTime % s->policy.boostPeriod == 0) {
+        for (int i = 0; i < s->n; i++) {
+            if (s->procs[i].finished) continue;
+            s->procs[i].level = 0;
+            s->procs[i].quantumUsed = 0;
+            s->procs[i].agedWait = 0;
+        }
+    }
+}
+
+/**************************************************
+Method Name: pick_fair
+Returns: int
+Input: Scheduler *s
+Precondition: Fair share mode is on and this tick has been accounted
+Task: Adds newly arrived processes to the run queue and returns the
+  process with the smallest virtual runtime, keeping the running process
+  until it has used its minimum granularity.
+ **************************************************/
+static int pick_fair(Scheduler *s) {
+    for (int i = 0; i < s->n; i++) {
+        if (i == s->running || s->procs[i].finished || s->procs[i].fair.queued) continue;
+        if (s->procs[i].arrival > (int)s->currentTime) continue;
+        fair_enqueue(&s->fairQueue, &s->procs[i].fair);
+    }
+
+    return fair_pick(&s->fairQueue, s->running != -1 ? &s->procs[s->running].fair : NULL);
+}
+
+/**************************************************
+Method Name: print_share_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished in fair share mode
+Task: Prints each process's share of the CPU while it was in the system
+  next to the share its weight entitled it to.
+ **************************************************/
+static void print_share_report(Scheduler *s) {
+    printf("\nCPU share by process (fair share, min granularity %d):\n", s->policy.minGranularity);
+    for (int i = 0; i < s->n; i++) {
+        int life = s->procs[i].finishTime - s->procs[i].arrival;
+        if (life <= 0) life = 1;
+        printf("Process %d: nice %d, weight %d, ran %d of %d seconds, share %.1f%%, entitled %.1f%%\n",
+               s->procs[i].processNum, s->procs[i].priority, s->procs[i].fair.weight,
+               s->procs[i].fair.ranTicks, life,
+               100.0 * s->procs[i].fair.ranTicks / life,
+               100.0 * s->procs[i].fair.entitledTicks / life);
+    }
+    fflush(stdout);
+}
+
+/**************************************************
+Method Name: print_wait_report
+Returns: void
+Input: Scheduler *s
+Precondition: All processes have finished
+Task: Prints the average and maximum waiting time for each priority
+  class so starvation of low priority processes is visible.
+ **************************************************/
+static void print_wait_report(Scheduler *s) {
+    int minPri = s->procs[0].priority;
+    int maxPri = s->procs[0].priority;
+    for (int i = 1; i < s->n; i++) {
+        if (s->procs[i].priority < minPri) minPri = s->procs[i].priority;
+        if (s->procs[i].priority > maxPri) maxPri = s->procs[i].priority;
+    }
+
+    printf("\nWaiting time by priority class (%s):\n",
+           s->policy.mlfqLevels > 0 ? "MLFQ" : s->policy.fairShare ? "fair share" : "priority");
+    for (int pri = minPri; pri <= maxPri; pri++) {
+        int count = 0, total = 0, maxWait = 0;
+        for (int i = 0; i < s->n; i++) {
+            if (s->procs[i].priority != pri) continue;
+            count++;
+            total += s->procs[i].waitTime;
+            if (s->procs[i].waitTime > maxWait) maxWait = s->procs[i].waitTime;
+        }
+        if (count == 0) continue;
+        printf("Priority %d: %d processes, avg wait %.2f, max wait %d\n",
+               pri, count, (double)total / count, maxWait);
+    }
+    fflush(stdout);
+}
+
+/**************************************************
+Method Name: check_progress
+Returns: void
+Input: Scheduler *s
+Precondition: Called at the start of a tick, while s->running is still
+  the process that ran during the last tick
+Task: Reads the running worker's progress record without signalling it.
+  With --progress prints how many numbers it tested in the last second.
+  Warns once if its heartbeat has not moved for HANG_TICKS running ticks.
+ **************************************************/
+static void check_progress(Scheduler *s) {
+    if (s->running == -1) return;
+    PCB *p = &s->procs[s->running];
+    const ProgressRecord *record = progress_record(s->running);
+    if (!record || p->finished) return;
+
+    uint64_t tested = atomic_load_explicit(&record->tested, memory_order_relaxed);
+    uint64_t heartbeat = atomic_load_explicit(&record->heartbeat, memory_order_relaxed);
+    if (showProgress && !s->quiet) {
+        printf("Progress: Process %d tested %.1f k/s, %llu primes, highest %llu\n", p->processNum,
+               (tested - p->lastTested) / 1000.0,
+               (unsigned long long)atomic_load_explicit(&record->found, memory_order_relaxed),
+               (unsigned long long)atomic_load_explicit(&record->highest, memory_order_relaxed));
+        fflush(stdout);
+    }
+    if (heartbeat == p->lastHeartbeat) {
+        p->stalledTicks++;
+        if (p->stalledTicks == HANG_TICKS && !s->quiet) {
+            printf("Warning: Process %d (Pid %d) has made no progress in %d seconds of running, it may be hung\n",
+                   p->processNum, (int)p->pid, HANG_TICKS);
             fflush(stdout);
-            kill(procs[running].pid, SIGTERM);
-            procs[running].finished = 1;
-            running = -1;
         }
+    } else {
+        p->stalledTicks = 0;
     }
+    p->lastTested = tested;
+    p->lastHeartbeat = heartbeat;
+}
 
-    if (all_finished()) {
-        printf("\nScheduler: Time Now: %d seconds\n", (int)currentTime);
+/**************************************************
+Method Name: print_work_report
+Returns: void
+Input: Scheduler *s
+Precondition: Every process in s has finished and the workers had a
+  progress page
+Task: With --kind, prints what each job did besides the prime search:
+  MB streamed, pointer hops and fsync'd writes, each with its rate per
+  second of CPU time the job was given. Prints nothing for cpu jobs.
+ **************************************************/
+static void print_work_report(Scheduler *s) {
+    int header = 0;
+    for (int i = 0; i < s->n; i++) {
+        const ProgressRecord *record = progress_record(i);
+        if (!record) continue;
+        double mb = atomic_load_explicit(&record->work[PROGRESS_STREAMED], memory_order_relaxed) / 1048576.0;
+        double hops = atomic_load_explicit(&record->work[PROGRESS_HOPS], memory_order_relaxed) / 1e6;
+        double syncs = (double)atomic_load_explicit(&record->work[PROGRESS_SYNCS], memory_order_relaxed);
+        if (mb == 0 && hops == 0 && syncs == 0) continue;
+        if (!header) {
+            printf("\nOther work (--kind):\n");
+            printf("%8s %12s %10s %10s %10s %10s %10s\n", "Process", "MB streamed", "MB/s", "M hops", "M hops/s",
+                   "Syncs", "Syncs/s");
+            header = 1;
+        }
+        int seconds = s->procs[i].burst - s->procs[i].remaining;
+        double per = seconds > 0 ? 1.0 / seconds : 0.0;
+        printf("%8d %12.0f %10.1f %10.1f %10.2f %10.0f %10.1f\n", s->procs[i].processNum, mb, mb * per, hops, hops * per,
+               syncs, syncs * per);
+    }
+}
+
+/**************************************************
+Method Name: print_progress_report
+Returns: void
+Input: Scheduler *s
+Precondition: Every process in s has finished and the workers had a
+  progress page
+Task: Prints each job's final progress record: numbers tested, primes
+  found, highest prime and the rate per second of CPU time it was given.
+ **************************************************/
+static void print_progress_report(Scheduler *s) {
+    printf("\nWorker progress:\n");
+    printf("%8s %14s %10s %22s %12s\n", "Process", "Tested", "Primes", "Highest", "k/s");
+    for (int i = 0; i < s->n; i++) {
+        const ProgressRecord *record = progress_record(i);
+        if (!record) continue;
+        uint64_t tested = atomic_load_explicit(&record->tested, memory_order_relaxed);
+        int seconds = s->procs[i].burst - s->procs[i].remaining;
+        printf("%8d %14llu %10llu %22llu %12.1f\n", s->procs[i].processNum, (unsigned long long)tested,
+               (unsigned long long)atomic_load_explicit(&record->found, memory_order_relaxed),
+               (unsigned long long)atomic_load_explicit(&record->highest, memory_order_relaxed),
+               seconds > 0 ? tested / 1000.0 / seconds : 0.0);
+    }
+    print_work_report(s);
+    fflush(stdout);
+}
+
+/**************************************************
+Method Name: print_fiber_report
+Returns: void
+Input: Scheduler *s
+Precondition: --fibers, every process in s has finished
+Task: Prints the cost of a fiber switch next to the cost of stopping and
+  continuing a process (the fork model), how long the running fiber took
+  to reach a safe point after each tick, and the search rate over all
+  jobs per second they ran, to compare with a run without --fibers.
+ **************************************************/
+static void print_fiber_report(Scheduler *s) {
+    long yields;
+    double meanNs, maxNs;
+    fiber_stats(&yields, &meanNs, &maxNs);
+    uint64_t tested = 0;
+    long long runNs = 0;
+    for (int i = 0; i < s->n; i++) {
+        tested += fiberJobs[i].tested;
+        runNs += job_run_ns(&fiberJobs[i]);
+    }
+    printf("\nFibers (%s):\n", fiber_method());
+    printf("Switch: %.0f ns to resume and yield a fiber, %.1f us to stop and continue a process (%.0fx)\n",
+           fiberSwitchNs, fiberStopNs / 1000.0, fiberSwitchNs > 0 ? fiberStopNs / fiberSwitchNs : 0.0);
+    printf("Preemption: %ld ticks, %.1f us mean and %.1f us max from the tick to the safe point\n", yields,
+           meanNs / 1000.0, maxNs / 1000.0);
+    printf("Throughput: %llu numbers tested, %.1f k/s over %.1f s of running\n", (unsigned long long)tested,
+           runNs > 0 ? tested * 1e6 / runNs : 0.0, runNs / 1e9);
+    fflush(stdout);
+}
+
+/**************************************************
+Method Name: finish_run
+Returns: void
+Input: Scheduler *s
+Precondition: Every process in s has finished
+Task: Prints the end of run reports, writes the trace and replay
+  results, and exits the scheduler.
+ **************************************************/
+static void finish_run(Scheduler *s) {
+    printf("\nScheduler: Time Now: %d seconds\n", (int)s->currentTime);
+    print_wait_report(s);
+    if (s->policy.fairShare) {
+        print_share_report(s);
+    }
+    if (!simulate) {
+        rt_jitter_report(stdout);
         fflush(stdout);
-        exit(0);
+    }
+    if (progressFd >= 0) {
+        print_progress_report(s);
+    }
+    if (useFibers) {
+        print_fiber_report(s);
+    }
+    if (trace_enabled()) {
+        trace_finish((int)s->currentTime);
+        if (tracePath && trace_write_json(tracePath) == 0) printf("Trace written to %s\n", tracePath);
+        if (gantt) trace_print_gantt(stdout);
+        fflush(stdout);
+    }
+    int status = replay_finish(stdout, tolerance);
+    fflush(stdout);
+    control_close();
+    exit(status);
+}
+
+/**************************************************
+Method Name: schedule_one_tick
+Returns: int
+Input: Scheduler *s
+Precondition: Called once per second (timer tick), after s->currentTime
+  has been advanced
+Task: Decrements remaining time for the currently running process.
+  If it reaches 0, terminate it and mark finished. Returns 1 if all
+  processes have finished. Otherwise picks the best ready process by
+  priority and, if needed, preempts the current process (SIGTSTP) and
+  starts/resumes the selected one (fork/exec or SIGCONT). Returns 0.
+ **************************************************/
+static int schedule_one_tick(Scheduler *s) {
+    account_waiting(s);
+    check_progress(s);
+
+    // Processes arriving now join the timeline as ready.
+    for (int i = 0; i < s->n; i++) {
+        if (s->procs[i].arrival == (int)s->currentTime) {
+            trace_state((int)s->currentTime, s->procs[i].processNum, TRACE_READY);
+            replay_arrival((int)s->currentTime, s->procs[i].processNum);
+        }
     }
 
-    // Choose the best ready process
-    int next = pick_next_ready();
+    if (s->policy.fairShare) {
+        fair_account_tick(&s->fairQueue, s->running != -1 ? &s->procs[s->running].fair : NULL);
+    }
+
+    if (s->running != -1) {
+        if (s->procs[s->running].remaining > 0) {
+            s->procs[s->running].remaining--;
+        }
+        replay_tick((int)s->currentTime, s->procs[s->running].processNum, s->procs[s->running].remaining);
+        if (s->procs[s->running].remaining == 0 && !s->procs[s->running].finished) {
+            if (!s->quiet) {
+                printf("\nScheduler: Time Now: %d seconds\n", (int)s->currentTime);
+                printf("Terminating Process %d (Pid %d)\n", s->procs[s->running].processNum, (int)s->procs[s->running].pid);
+                fflush(stdout);
+            }
+            send_signal(s, s->running, SIGTERM);
+            s->procs[s->running].finished = 1;
+            s->procs[s->running].finishTime = (int)s->currentTime;
+            trace_state((int)s->currentTime, s->procs[s->running].processNum, TRACE_DONE);
+            s->running = -1;
+        }
+    } else {
+        replay_tick((int)s->currentTime, -1, 0);
+    }
+
+    if (s->policy.mlfqLevels > 0) {
+        mlfq_tick(s);
+    }
+
+    // With a control socket the scheduler idles until it is told to shut down.
+    if (all_finished(s) && (!controlPath || shutdownRequested)) {
+        return 1;
+    }
+
+    // Choose the best ready process, timing the selection path for replay
+    uint64_t selectStart = replay_active() ? replay_clock_ns() : 0;
+    int next = s->policy.fairShare ? pick_fair(s) : pick_next_ready(s);
+    if (replay_active()) {
+        replay_select((int)s->currentTime, s->running != -1 ? s->procs[s->running].processNum : -1,
+                      next != -1 ? s->procs[next].processNum : -1, replay_clock_ns() - selectStart);
+    }
     if (next == -1) {
-        return;
+        return 0;
     }
 
     // Preempt/switch
-    if (next != running) {
-      printf("\nScheduler: Time Now: %d seconds\n", (int)currentTime);
+    if (next != s->running) {
+      if (!s->quiet) printf("\nScheduler: Time Now: %d seconds\n", (int)s->currentTime);
 
-      if (running != -1) {
+      if (s->running != -1) {
           // If next hasn't started yet, fork it first so PID exists
-          if (!procs[next].started) {
-              fork_and_exec(next);
-              procs[next].started = 1;
+          if (!s->procs[next].started) {
+              start_process(s, next);
           }
 
-          printf("Suspending Process %d (Pid %d) and Resuming Process %d (Pid %d)\n",
-                 procs[running].processNum, (int)procs[running].pid,
-                 procs[next].processNum, (int)procs[next].pid);
-          fflush(stdout);
+          if (!s->quiet) {
+              printf("Suspending Process %d (Pid %d) and Resuming Process %d (Pid %d)\n",
+                     s->procs[s->running].processNum, (int)s->procs[s->running].pid,
+                     s->procs[next].processNum, (int)s->procs[next].pid);
+              fflush(stdout);
+          }
 
-          kill(procs[running].pid, SIGTSTP);
-          kill(procs[next].pid, SIGCONT);
+          send_signal(s, s->running, SIGTSTP);
+          send_signal(s, next, SIGCONT);
+          trace_state((int)s->currentTime, s->procs[s->running].processNum, TRACE_STOPPED);
+          trace_preempt((int)s->currentTime, s->procs[s->running].processNum);
       }
       else {
-        if (!procs[next].started) {
-            fork_and_exec(next);
-            procs[next].started = 1;
+        if (!s->procs[next].started) {
+            start_process(s, next);
 
-            printf("Scheduling to Process %d (Pid %d)\n",
-                   procs[next].processNum, (int)procs[next].pid);
-            fflush(stdout);
-        } else {
+            if (!s->quiet) {
+                printf("Scheduling to Process %d (Pid %d)\n",
+                       s->procs[next].processNum, (int)s->procs[next].pid);
+                fflush(stdout);
+            }
+        } else if (!s->quiet) {
             printf("Resuming Process %d (Pid %d)\n",
-                   procs[next].processNum, (int)procs[next].pid);
+                   s->procs[next].processNum, (int)s->procs[next].pid);
             fflush(stdout);
         }
 
-          kill(procs[next].pid, SIGCONT);
+          send_signal(s, next, SIGCONT);
       }
 
-    running = next;
+    if (s->policy.fairShare) {
+        fair_switch(&s->fairQueue, s->running != -1 ? &s->procs[s->running].fair : NULL, &s->procs[next].fair);
+    }
+    trace_state((int)s->currentTime, s->procs[next].processNum, TRACE_RUNNING);
+    s->running = next;
+    s->dispatches++;
     }
+    return 0;
 }
 
 /**************************************************
@@ -179,69 +793,669 @@ Method Name: timer_handler
 Returns: void
 Input: int signum
 Precondition: Triggered by SIGALRM once per second
-Task: Increments scheduler time and runs one scheduling tick.
+Task: Records how late the tick arrived, increments scheduler time
+  and runs one scheduling tick on the live scheduler.
  **************************************************/
 static void timer_handler(int signum) {
     (void)signum;
-    currentTime++;
-    schedule_one_tick();
+    rt_jitter_record();
+    live.currentTime++;
+    if (schedule_one_tick(&live)) finish_run(&live);
+    if (useFibers) fiber_preempt();
+}
+
+/**************************************************
+Method Name: run_fibers
+Returns: void
+Input: N/A
+Precondition: --fibers, the timer is running
+Task: The scheduler's main loop with --fibers. Runs the fiber of the job
+  the last tick chose until the next tick makes it yield, then frees the
+  stacks of ended jobs. With no job to run it sleeps until the next
+  tick. SIGALRM is blocked while the choice is read. Never returns.
+ **************************************************/
+static void run_fibers(void) {
+    sigset_t alarm, unblocked;
+    sigemptyset(&alarm);
+    sigaddset(&alarm, SIGALRM);
+    while (1) {
+        sigprocmask(SIG_BLOCK, &alarm, &unblocked);
+        int idx = live.running;
+        if (idx == -1 || !live.procs[idx].started || fiberJobs[idx].ended) {
+            sigsuspend(&unblocked);
+            sigprocmask(SIG_SETMASK, &unblocked, NULL);
+            continue;
+        }
+        FiberJob *job = &fiberJobs[idx];
+        fiberPreempt = 0;
+        progress_use(idx);
+        sigprocmask(SIG_SETMASK, &unblocked, NULL);
+
+        job->ran = 1;
+        job->runStart = (long long)replay_clock_ns();
+        fiber_resume(&job->fiber);
+        job->runNs += (long long)replay_clock_ns() - job->runStart;
+        job->runStart = 0;
+
+        sigprocmask(SIG_BLOCK, &alarm, NULL);
+        for (int i = 0; i < live.n; i++) {
+            if (fiberJobs[i].ended && fiberJobs[i].fiber.stack) fiber_free(&fiberJobs[i].fiber);
+        }
+        sigprocmask(SIG_SETMASK, &unblocked, NULL);
+    }
+}
+
+/**************************************************
+Method Name: start_level
+Returns: int
+Input: Scheduler *s, int priority
+Precondition: MLFQ mode is on
+Task: Returns the level a process with this priority starts at
+  (priority 1 starts at level 0), capped at the lowest level.
+ **************************************************/
+static int start_level(Scheduler *s, int priority) {
+    int level = priority - 1;
+    if (level < 0) level = 0;
+    if (level > s->policy.mlfqLevels - 1) level = s->policy.mlfqLevels - 1;
+    return level;
+}
+
+/**************************************************
+Method Name: add_process
+Returns: int
+Input: Scheduler *s, int processNum, int arrival, int burst, int priority
+Precondition: s->n < s->cap
+Task: Appends a process to procs[] with fresh PCB state and returns its
+  index. In MLFQ mode it starts at the level matching its priority.
+ **************************************************/
+static int add_process(Scheduler *s, int processNum, int arrival, int burst, int priority) {
+    PCB p;
+    p.processNum = processNum;
+    p.arrival = arrival;
+    p.burst = burst;
+    p.priority = priority;
+    p.remaining = burst;
+    p.started = 0;
+    p.finished = 0;
+    p.pid = -1;
+    p.level = s->policy.mlfqLevels > 0 ? start_level(s, priority) : 0;
+    p.quantumUsed = 0;
+    p.seq = s->nextSeq++;
+    p.waitTime = 0;
+    p.agedWait = 0;
+    p.finishTime = 0;
+    p.lastTested = 0;
+    p.lastHeartbeat = 0;
+    p.stalledTicks = 0;
+    fair_entity_init(&p.fair, s->n, priority);
+    if (processNum >= s->nextProcessNum) s->nextProcessNum = processNum + 1;
+    s->procs[s->n] = p;
+    return s->n++;
 }
 
 /**************************************************
 Method Name: read_input
 Returns: void
-Input: const char *filename
+Input: Scheduler *s, const char *filename
 Precondition: filename points to a readable text file where each line
   contains: processNum arrival burst priority
 Task: Reads process definitions from file into procs[] and initializes
   PCB fields (remaining/started/finished/pid).
  **************************************************/
-static void read_input(const char *filename) {
+static void read_input(Scheduler *s, const char *filename) {
     FILE *f = fopen(filename, "r");
     if (!f) {
         perror("fopen");
         exit(1);
     }
-    n = 0;
-    while (n < 10) {
-        PCB p;
-        int got = fscanf(f, "%d %d %d %d",
-                         &p.processNum, &p.arrival, &p.burst, &p.priority);
+    s->n = 0;
+    while (s->n < s->cap) {
+        int processNum, arrival, burst, priority;
+        int got = fscanf(f, "%d %d %d %d", &processNum, &arrival, &burst, &priority);
         if (got == EOF) break;
         if (got != 4) {
             fprintf(stderr, "Bad input line (expected 4 ints).\n");
             exit(1);
         }
-        p.remaining = p.burst;
-        p.started = 0;
-        p.finished = 0;
-        p.pid = -1;
-        procs[n++] = p;
+        add_process(s, processNum, arrival, burst, priority);
     }
 
     fclose(f);
-    if (n == 0) {
+    if (s->n == 0 && !controlPath) {
         fprintf(stderr, "No processes found in input.\n");
         exit(1);
     }
 }
 
+/**************************************************
+Method Name: parse_quanta
+Returns: int
+Input: int *quanta, const char *list
+Precondition: list is a comma separated list of positive integers
+Task: Fills quanta[] from list. Levels without a value get double the
+  previous level's quantum. Returns 0 if list is malformed.
+ **************************************************/
+static int parse_quanta(int *quanta, const char *list) {
+    int count = 0;
+    const char *s = list;
+
+    while (*s && count < MAX_LEVELS) {
+        char *end;
+        long q = strtol(s, &end, 10);
+        if (end == s || q <= 0) return 0;
+        quanta[count++] = (int)q;
+        if (*end == ',') end++;
+        else if (*end != '\0') return 0;
+        s = end;
+    }
+    for (int i = count; i < MAX_LEVELS; i++) {
+        quanta[i] = i == 0 ? 1 : quanta[i - 1] * 2;
+    }
+    return 1;
+}
+
+/**************************************************
+Method Name: policy_init
+Returns: void
+Input: Policy *policy
+Precondition: N/A
+Task: Sets the default policy: plain priority scheduling.
+ **************************************************/
+static void policy_init(Policy *policy) {
+    memset(policy, 0, sizeof(*policy));
+    parse_quanta(policy->quanta, "1");
+    policy->minGranularity = 1;
+}
+
+/**************************************************
+Method Name: parse_arguments
+Returns: int
+Input: int argc, char **argv, Policy *policy
+Precondition: argv holds the command line (or one sweep grid line)
+Task: Reads the scheduling options into policy and the run options into
+  the file globals. Returns the index of the first input file argument
+  (argc if there is none), or -1 if the command line is invalid.
+ **************************************************/
+static int parse_arguments(int argc, char **argv, Policy *policy) {
+    int option;
+    static const struct option longOptions[] = {
+        { "trace", required_argument, NULL, 'T' },
+        { "gantt", no_argument, NULL, 'G' },
+        { "rt", no_argument, NULL, 'R' },
+        { "record", required_argument, NULL, 'W' },
+        { "replay", required_argument, NULL, 'P' },
+        { "tolerance", required_argument, NULL, 'X' },
+        { "sweep", required_argument, NULL, 'S' },
+        { "csv", required_argument, NULL, 'O' },
+        { "threads", required_argument, NULL, 'J' },
+        { "sieve", no_argument, NULL, 'V' },
+        { "worker-threads", required_argument, NULL, 'K' },
+        { "progress", no_argument, NULL, 'Y' },
+        { "checkpoint", required_argument, NULL, 'Z' },
+        { "wide", required_argument, NULL, 'U' },
+        { "kind", required_argument, NULL, 'N' },
+        { "fibers", no_argument, NULL, 'F' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    policy_init(policy);
+    optind = 0; // Full getopt reset, parse_arguments also reads every sweep grid line
+    while ((option = getopt_long(argc, argv, "m:q:b:a:fg:sT:Gc:", longOptions, NULL)) != -1) {
+        switch (option) {
+        case 'm':
+            policy->mlfqLevels = atoi(optarg);
+            if (policy->mlfqLevels < 1 || policy->mlfqLevels > MAX_LEVELS) {
+                fprintf(stderr, "Number of levels must be between 1 and %d.\n", MAX_LEVELS);
+                return -1;
+            }
+            break;
+        case 'q':
+            if (!parse_quanta(policy->quanta, optarg)) {
+                fprintf(stderr, "Bad quantum list: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'b':
+            policy->boostPeriod = atoi(optarg);
+            break;
+        case 'a':
+            policy->agingLimit = atoi(optarg);
+            break;
+        case 'f':
+            policy->fairShare = 1;
+            break;
+        case 'g':
+            policy->minGranularity = atoi(optarg);
+            if (policy->minGranularity < 1) {
+                fprintf(stderr, "Minimum granularity must be at least 1.\n");
+                return -1;
+            }
+            break;
+        case 's':
+            simulate = 1;
+            break;
+        case 'T':
+            tracePath = optarg;
+            break;
+        case 'G':
+            gantt = 1;
+            break;
+        case 'R':
+            realTime = 1;
+            break;
+        case 'c':
+            controlPath = optarg;
+            break;
+        case 'W':
+            recordPath = optarg;
+            break;
+        case 'P':
+            replayPath = optarg;
+            break;
+        case 'X':
+            tolerance = atof(optarg);
+            break;
+        case 'S':
+            sweepPath = optarg;
+            break;
+        case 'O':
+            csvPath = optarg;
+            break;
+        case 'J':
+            sweepThreads = atoi(optarg);
+            break;
+        case 'V':
+            workerSieve = 1;
+            break;
+        case 'K':
+            workerThreads = optarg;
+            break;
+        case 'Y':
+            showProgress = 1;
+            break;
+        case 'Z':
+            checkpointDir = optarg;
+            break;
+        case 'N':
+            workKind = optarg;
+            break;
+        case 'F':
+            useFibers = 1;
+            break;
+        case 'U':
+            wideBits = optarg;
+            if (atoi(wideBits) < 64 || atoi(wideBits) > 127) {
+                fprintf(stderr, "--wide takes a bit count from 64 to 127.\n");
+                return -1;
+            }
+            break;
+        default:
+            return -1;
+        }
+    }
+
+    if (policy->fairShare && policy->mlfqLevels > 0) {
+        fprintf(stderr, "Choose either -m (MLFQ) or -f (fair share), not both.\n");
+        return -1;
+    }
+    if (workerSieve && wideBits) {
+        fprintf(stderr, "Choose either --sieve or --wide, the sieve cannot reach past 2^64.\n");
+        return -1;
+    }
+    if (useFibers && (simulate || controlPath || workerSieve || workerThreads || wideBits || workKind || checkpointDir)) {
+        fprintf(stderr, "--fibers runs the default prime search in the scheduler, without -s, -c or worker options.\n");
+        return -1;
+    }
+    if (controlPath && simulate) {
+        fprintf(stderr, "The control socket needs the real-time clock, not -s.\n");
+        return -1;
+    }
+    if (recordPath && replayPath) {
+        fprintf(stderr, "Choose either --record or --replay, not both.\n");
+        return -1;
+    }
+    if (sweepPath && (tracePath || gantt || realTime || controlPath || recordPath || replayPath || useFibers)) {
+        fprintf(stderr, "--sweep only combines with scheduling options.\n");
+        return -1;
+    }
+    return optind;
+}
+
+/**************************************************
+Method Name: assign_levels
+Returns: void
+Input: Scheduler *s
+Precondition: procs[] is loaded and MLFQ mode is on
+Task: Places each process in its starting level from its priority.
+  add_process() already does this, so it is only needed when a sweep
+  run gives processes loaded under another policy its own MLFQ levels.
+ **************************************************/
+static void assign_levels(Scheduler *s) {
+    for (int i = 0; i < s->n; i++) {
+        s->procs[i].level = start_level(s, s->procs[i].priority);
+    }
+}
+
+/**************************************************
+Method Name: find_process
+Returns: int
+Input: Scheduler *s, int processNum
+Precondition: N/A
+Task: Returns the index in procs[] of processNum, or -1 if unknown.
+ **************************************************/
+static int find_process(Scheduler *s, int processNum) {
+    for (int i = 0; i < s->n; i++) {
+        if (s->procs[i].processNum == processNum) return i;
+    }
+    return -1;
+}
+
+/**************************************************
+Method Name: set_priority
+Returns: void
+Input: Scheduler *s, int idx, int priority
+Precondition: idx is a valid index in procs[]
+Task: Changes a process's priority. In MLFQ mode it moves to the level
+  for the new priority with a fresh quantum, and in fair share mode its
+  weight follows the new nice value.
+ **************************************************/
+static void set_priority(Scheduler *s, int idx, int priority) {
+    s->procs[idx].priority = priority;
+    if (s->policy.mlfqLevels > 0) {
+        s->procs[idx].level = start_level(s, priority);
+        s->procs[idx].quantumUsed = 0;
+    }
+    if (s->policy.fairShare) {
+        int queued = s->procs[idx].fair.queued;
+        if (queued) fair_dequeue(&s->fairQueue, &s->procs[idx].fair);
+        s->procs[idx].fair.weight = fair_weight(priority);
+        if (queued) fair_enqueue(&s->fairQueue, &s->procs[idx].fair);
+    }
+}
+
+/**************************************************
+Method Name: cancel_process
+Returns: void
+Input: Scheduler *s, int idx
+Precondition: idx is a valid index in procs[] and not finished
+Task: Terminates a process early. A stopped child is continued so it
+  can act on SIGTERM.
+ **************************************************/
+static void cancel_process(Scheduler *s, int idx) {
+    printf("\nScheduler: Time Now: %d seconds\n", (int)s->currentTime);
+    printf("Cancelling Process %d (Pid %d)\n", s->procs[idx].processNum, (int)s->procs[idx].pid);
+    fflush(stdout);
+
+    if (s->procs[idx].started) {
+        send_signal(s, idx, SIGTERM);
+        send_signal(s, idx, SIGCONT);
+    }
+    if (s->policy.fairShare && s->procs[idx].fair.queued) {
+        fair_dequeue(&s->fairQueue, &s->procs[idx].fair);
+    }
+    s->procs[idx].finished = 1;
+    s->procs[idx].finishTime = (int)s->currentTime;
+    trace_state((int)s->currentTime, s->procs[idx].processNum, TRACE_DONE);
+    if (s->running == idx) s->running = -1;
+}
+
+/**************************************************
+Method Name: handle_control_request
+Returns: void
+Input: const CtlRequest *req, const CtlJob *jobs, CtlReply *reply
+Precondition: Called by control_serve() with SIGALRM blocked
+Task: Applies one control request to the live scheduler and fills in the reply with the
+  current queue stats. Submitted jobs arrive at the next tick and are
+  numbered after the highest processNum so far.
+ **************************************************/
+static void handle_control_request(const CtlRequest *req, const CtlJob *jobs, CtlReply *reply) {
+    Scheduler *s = &live;
+    int idx;
+    reply->status = CTL_OK;
+
+    switch (req->op) {
+    case CTL_SUBMIT:
+        reply->firstProcessNum = s->nextProcessNum;
+        for (int j = 0; j < req->count; j++) {
+            if (jobs[j].burst < 1) {
+                reply->status = CTL_BAD_REQUEST;
+                break;
+            }
+            if (s->n == s->cap) {
+                reply->status = CTL_FULL;
+                break;
+            }
+            add_process(s, s->nextProcessNum, (int)s->currentTime + 1, jobs[j].burst, jobs[j].priority);
+            reply->accepted++;
+        }
+        break;
+    case CTL_PRIORITY:
+        idx = find_process(s, req->processNum);
+        if (idx < 0 || s->procs[idx].finished) reply->status = CTL_NO_SUCH_JOB;
+        else set_priority(s, idx, req->priority);
+        break;
+    case CTL_CANCEL:
+        idx = find_process(s, req->processNum);
+        if (idx < 0 || s->procs[idx].finished) reply->status = CTL_NO_SUCH_JOB;
+        else cancel_process(s, idx);
+        break;
+    case CTL_STATS:
+        break;
+    case CTL_SHUTDOWN:
+        shutdownRequested = 1;
+        break;
+    default:
+        reply->status = CTL_BAD_REQUEST;
+        break;
+    }
+
+    reply->currentTime = (int32_t)s->currentTime;
+    reply->total = s->n;
+    reply->running = s->running != -1 ? s->procs[s->running].processNum : -1;
+    for (int i = 0; i < s->n; i++) {
+        if (s->procs[i].finished) reply->finished++;
+        else if (i != s->running && s->procs[i].arrival <= (int)s->currentTime) reply->ready++;
+    }
+
+    long ticks;
+    long long maxNs, sumNs;
+    rt_jitter_stats(&ticks, &maxNs, &sumNs);
+    reply->ticks = ticks;
+    reply->latenessMaxNs = maxNs;
+    reply->latenessSumNs = sumNs;
+}
+
+// Inputs and results of a --sweep, shared read-only by the pool threads
+typedef struct {
+    Policy *policies;
+    int nTraces;
+    PCB **traceProcs;       // Each input file as loaded by read_input
+    int *traceCounts;
+    SweepResult *results;   // One slot per run, written only by that run
+} Sweep;
+
+/**************************************************
+Method Name: sweep_one
+Returns: void
+Input: int run, void *ctx
+Precondition: ctx is the Sweep and run < policies x traces
+Task: Runs one policy over one input file on its own scheduler instance
+  and virtual clock, then stores the run's metrics. A run that goes past
+  the last arrival plus the total burst (a job can never finish) is
+  stopped and reported as not finished.
+ **************************************************/
+static void sweep_one(int run, void *ctx) {
+    Sweep *sw = ctx;
+    int t = run % sw->nTraces;
+    SweepResult *r = &sw->results[run];
+    int count = sw->traceCounts[t];
+
+    Scheduler *s = calloc(1, sizeof(*s));
+    PCB *procs = malloc(sizeof(PCB) * (size_t)count);
+    if (!s || !procs) {
+        free(s);
+        free(procs);
+        return;
+    }
+    memcpy(procs, sw->traceProcs[t], sizeof(PCB) * (size_t)count);
+    s->policy = sw->policies[run / sw->nTraces];
+    s->procs = procs;
+    s->n = count;
+    s->cap = count;
+    s->running = -1;
+    s->nextSeq = count;
+    s->quiet = 1;
+    if (s->policy.mlfqLevels > 0) {
+        assign_levels(s);
+    }
+    if (s->policy.fairShare) {
+        fair_init(&s->fairQueue, s->policy.minGranularity);
+    }
+
+    int limit = 1;
+    for (int i = 0; i < count; i++) {
+        if (procs[i].arrival > limit) limit = procs[i].arrival;
+    }
+    for (int i = 0; i < count; i++) limit += procs[i].burst;
+
+    do {
+        s->currentTime++;
+    } while (!schedule_one_tick(s) && s->currentTime <= limit);
+
+    r->ok = all_finished(s);
+    r->jobs = count;
+    r->makespan = (int)s->currentTime;
+    r->dispatches = s->dispatches;
+    long turnaround = 0, wait = 0;
+    for (int i = 0; i < count; i++) {
+        turnaround += procs[i].finishTime - procs[i].arrival;
+        wait += procs[i].waitTime;
+        if (procs[i].waitTime > r->maxWait) r->maxWait = procs[i].waitTime;
+    }
+    r->avgTurnaround = count ? (double)turnaround / count : 0.0;
+    r->avgWait = count ? (double)wait / count : 0.0;
+
+    free(procs);
+    free(s);
+}
+
+/**************************************************
+Method Name: run_sweep
+Returns: int
+Input: char **traces, int nTraces
+Precondition: sweepPath is set
+Task: Expands the grid, parses every configuration, loads every input
+  file, runs all configuration x input pairs on the thread pool and
+  writes the CSV. Returns the exit status.
+ **************************************************/
+static int run_sweep(char **traces, int nTraces) {
+    char **configs;
+    int nConfigs = sweep_expand_grid(sweepPath, &configs);
+    if (nConfigs <= 0) {
+        fprintf(stderr, "No configurations in %s\n", sweepPath);
+        return 1;
+    }
+
+    Sweep sw;
+    sw.nTraces = nTraces;
+    sw.policies = malloc(sizeof(Policy) * (size_t)nConfigs);
+    sw.traceProcs = malloc(sizeof(PCB *) * (size_t)nTraces);
+    sw.traceCounts = malloc(sizeof(int) * (size_t)nTraces);
+    sw.results = calloc((size_t)nConfigs * (size_t)nTraces, sizeof(SweepResult));
+    if (!sw.policies || !sw.traceProcs || !sw.traceCounts || !sw.results) return 1;
+
+    // getopt and read_input are not thread safe, so everything is parsed up front.
+    for (int c = 0; c < nConfigs; c++) {
+        char line[1024];
+        char *args[SWEEP_MAX_ARGS + 1];
+        snprintf(line, sizeof(line), "%s", configs[c]);
+        int argc = sweep_split(line, args, SWEEP_MAX_ARGS);
+        if (parse_arguments(argc, args, &sw.policies[c]) != argc) {
+            fprintf(stderr, "Bad configuration in %s: %s\n", sweepPath, configs[c]);
+            return 1;
+        }
+    }
+    for (int t = 0; t < nTraces; t++) {
+        read_input(&live, traces[t]);
+        sw.traceCounts[t] = live.n;
+        sw.traceProcs[t] = malloc(sizeof(PCB) * (size_t)live.n);
+        if (!sw.traceProcs[t]) return 1;
+        memcpy(sw.traceProcs[t], live.procs, sizeof(PCB) * (size_t)live.n);
+        live.nextSeq = 0;
+        live.nextProcessNum = 0;
+    }
+
+    sweep_run(nConfigs * nTraces, sweepThreads, sweep_one, &sw);
+    return sweep_write_csv(csvPath, traces, nTraces, configs, nConfigs, sw.results) == 0 ? 0 : 1;
+}
+
 /**************************************************
 Method Name: main
 Returns: int
 Input: int argc, char **argv
-Precondition: Program must be run as ./scheduler input.txt
-Task: Initializes scheduler state, installs SIGALRM handler,
-  starts a 1-second interval timer, and loops forever while
+Precondition: Program must be run as ./scheduler input.txt (or with --sweep)
+Task: Runs a sweep if asked. Otherwise initializes scheduler state, installs SIGALRM handler,
+  starts a 1-second interval timer, and sleeps in pause() while
   scheduling happens on each timer tick.
  **************************************************/
 int main(int argc, char **argv) {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s input.txt\n", argv[0]);
+    live.procs = liveProcs;
+    live.cap = MAX_PROCS;
+    live.running = -1;
+
+    int fileArg = parse_arguments(argc, argv, &live.policy);
+    if (fileArg < 0 || (sweepPath ? fileArg >= argc : fileArg != argc - 1)) {
+        fprintf(stderr, "Usage: %s [-m levels] [-q q0,q1,...] [-b boost] [-a aging] [-f [-g granularity]] [--trace out.json] [--gantt] [--rt] [--record log.bin | --replay log.bin [--tolerance pct]] [-c control.sock] [--sieve | --wide 64-127] [--worker-threads N] [--kind cpu|mem|cache|io|mixed[:size]] [--progress] [--checkpoint dir] [--fibers] [-s] input.txt\n", argv[0]);
+        fprintf(stderr, "       %s --sweep grid.txt [--threads N] [--csv out.csv] input.txt...\n", argv[0]);
         return 1;
     }
 
-    read_input(argv[1]);
+    if (sweepPath) {
+        simulate = 1;
+        return run_sweep(argv + fileArg, argc - fileArg);
+    }
+
+    read_input(&live, argv[fileArg]);
+    if (live.policy.fairShare) {
+        fair_init(&live.fairQueue, live.policy.minGranularity);
+    }
+    if ((tracePath || gantt) && trace_init(MAX_PROCS) != 0) {
+        fprintf(stderr, "Could not allocate the trace buffers\n");
+        return 1;
+    }
+    if (recordPath && replay_record_open(recordPath) != 0) return 1;
+    if (replayPath && replay_check_open(replayPath) != 0) return 1;
+    if (controlPath && control_open(controlPath) != 0) return 1;
+
+    // Simulated mode: drive the ticks directly on a virtual clock
+    if (simulate) {
+        while (1) {
+            live.currentTime++;
+            if (schedule_one_tick(&live)) finish_run(&live);
+        }
+    }
+
+    if (realTime) {
+        rt_harden();
+    }
+
+    // One progress record per process slot, shared with the workers
+    progressFd = progress_create(MAX_PROCS);
+    if (progressFd < 0) {
+        perror("Warning: no worker progress page");
+    }
+
+    // --fibers: time both kinds of switch while nothing else runs
+    if (useFibers) {
+        fiberJobs = calloc(MAX_PROCS, sizeof(FiberJob));
+        if (!fiberJobs) {
+            fprintf(stderr, "Could not allocate the fiber jobs\n");
+            return 1;
+        }
+        fiberSwitchNs = fiber_switch_ns(1000000);
+        fiberStopNs = fiber_stop_ns(2000);
+    }
+
     struct sigaction sa;
     memset(&sa, 0, sizeof(sa));
     sa.sa_handler = timer_handler;
@@ -257,6 +1471,14 @@ int main(int argc, char **argv) {
         perror("setitimer");
         return 1;
     }
+    rt_jitter_start(1000000000L);
 
-    while (1) { }
+    // Sleep between ticks instead of spinning so the scheduler does not
+    // compete with its own children for the CPU. With a control socket the
+    // wait also wakes up for requests, which are applied between ticks.
+    if (controlPath) {
+        while (1) control_serve(handle_control_request);
+    }
+    if (useFibers) run_fibers();
+    while (1) pause();
 }
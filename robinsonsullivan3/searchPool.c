@@ -0,0 +1,279 @@
+// File: searchPool.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "searchPool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define DEQUE_SIZE 64 // Ranges one thread can hold (a power of two)
+#define CLAIM_BATCH 8 // Ranges taken from the frontier at a time
+
+// Chase-Lev work-stealing deque of range start values. The owner pushes
+// and pops at the bottom, other threads steal from the top.
+typedef struct {
+    _Alignas(64) _Atomic int64_t top;
+    _Alignas(64) _Atomic int64_t bottom;
+    _Atomic uint64_t ranges[DEQUE_SIZE];
+} Deque;
+
+enum { DEQUE_EMPTY, DEQUE_OK, DEQUE_ABORT };
+
+static Deque *deques;
+static int nThreads = 0;
+static uint64_t rangeLength;
+static RangeSearch searchRange;
+static void *searchArg;
+
+static _Atomic uint64_t frontier;  // First candidate no thread has claimed yet
+static _Atomic uint64_t highest;   // Largest prime found by any thread
+static _Atomic uint64_t tested;    // Candidates in finished ranges
+
+// Parking: the signal thread sets parkRequested and waits until every
+// worker has stopped at a range boundary.
+static atomic_int parkRequested;
+static int parked = 0;
+static pthread_mutex_t parkLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t allParked = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t resumed = PTHREAD_COND_INITIALIZER;
+
+/**************************************************
+Method Name: deque_push
+Returns: void
+Input: Deque *d, uint64_t range
+Precondition: Called only by the owner, with fewer than DEQUE_SIZE ranges held
+Task: Adds a range at the bottom.
+ **************************************************/
+static void deque_push(Deque *d, uint64_t range) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    atomic_store_explicit(&d->ranges[b & (DEQUE_SIZE - 1)], range, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+}
+
+/**************************************************
+Method Name: deque_pop
+Returns: int
+Input: Deque *d, uint64_t *range
+Precondition: Called only by the owner
+Task: Takes the newest range from the bottom. Returns DEQUE_OK or
+  DEQUE_EMPTY (also when a thief won the race for the last range).
+ **************************************************/
+static int deque_pop(Deque *d, uint64_t *range) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return DEQUE_EMPTY;
+    }
+    *range = atomic_load_explicit(&d->ranges[b & (DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (t == b) {
+        // Last range: race the thieves for it.
+        int won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                          memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return won ? DEQUE_OK : DEQUE_EMPTY;
+    }
+    return DEQUE_OK;
+}
+
+/**************************************************
+Method Name: deque_steal
+Returns: int
+Input: Deque *d, uint64_t *range
+Precondition: N/A
+Task: Takes the oldest range from the top. Returns DEQUE_OK, DEQUE_EMPTY,
+  or DEQUE_ABORT if another thread took it first.
+ **************************************************/
+static int deque_steal(Deque *d, uint64_t *range) {
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return DEQUE_EMPTY;
+    *range = atomic_load_explicit(&d->ranges[t & (DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return DEQUE_ABORT;
+    }
+    return DEQUE_OK;
+}
+
+/**************************************************
+Method Name: next_range
+Returns: uint64_t
+Input: int me
+Precondition: Called by pool thread me
+Task: Returns the next range to search: the thread's own newest range,
+  else one stolen from another thread, else a new batch claimed from the
+  frontier (the first is returned, the rest are queued so idle threads
+  can steal them, lowest ranges first).
+ **************************************************/
+static uint64_t next_range(int me) {
+    uint64_t range;
+    if (deque_pop(&deques[me], &range) == DEQUE_OK) return range;
+
+    for (int i = 1; i < nThreads; i++) {
+        Deque *victim = &deques[(me + i) % nThreads];
+        int result;
+        while ((result = deque_steal(victim, &range)) == DEQUE_ABORT) { }
+        if (result == DEQUE_OK) return range;
+    }
+
+    uint64_t first = atomic_fetch_add(&frontier, CLAIM_BATCH * rangeLength);
+    // Push the highest first so the owner pops in increasing order.
+    for (int i = CLAIM_BATCH - 1; i > 0; i--) deque_push(&deques[me], first + i * rangeLength);
+    return first;
+}
+
+/**************************************************
+Method Name: record_prime
+Returns: void
+Input: uint64_t prime
+Precondition: N/A
+Task: Atomic max: raises highest to prime unless it is already larger.
+ **************************************************/
+static void record_prime(uint64_t prime) {
+    uint64_t current = atomic_load(&highest);
+    while (prime > current && !atomic_compare_exchange_weak(&highest, &current, prime)) { }
+}
+
+/**************************************************
+Method Name: park_here
+Returns: void
+Input: N/A
+Precondition: parkRequested is set
+Task: Counts this thread as parked and sleeps until pool_resume().
+ **************************************************/
+static void park_here(void) {
+    pthread_mutex_lock(&parkLock);
+    parked++;
+    pthread_cond_signal(&allParked);
+    while (atomic_load(&parkRequested)) pthread_cond_wait(&resumed, &parkLock);
+    parked--;
+    pthread_mutex_unlock(&parkLock);
+}
+
+/**************************************************
+Method Name: pool_thread
+Returns: void *
+Input: void *arg
+Precondition: arg is the thread's index
+Task: Searches ranges until the process exits, parking between ranges
+  when asked to.
+ **************************************************/
+static void *pool_thread(void *arg) {
+    int me = (int)(intptr_t)arg;
+    while (1) {
+        if (atomic_load(&parkRequested)) park_here();
+        uint64_t from = next_range(me);
+        uint64_t prime = searchRange(me, from, rangeLength, searchArg);
+        if (prime) record_prime(prime);
+        atomic_fetch_add(&tested, rangeLength);
+    }
+    return NULL;
+}
+
+/**************************************************
+Method Name: pool_start
+Returns: int
+Input: int threads, uint64_t start, uint64_t rangeSize, RangeSearch search, void *arg
+Precondition: Called once. The caller has blocked the signals it wants to
+  handle itself, so the pool threads inherit the blocked mask.
+Task: Starts threads that search upward from start in ranges of
+  rangeSize candidates. Returns 0 on success, -1 on failure.
+ **************************************************/
+int pool_start(int threads, uint64_t start, uint64_t rangeSize, RangeSearch search, void *arg) {
+    if (threads < 1 || threads > POOL_MAX_THREADS) return -1;
+    deques = aligned_alloc(64, sizeof(Deque) * threads);
+    if (!deques) return -1;
+    for (int i = 0; i < threads; i++) {
+        atomic_init(&deques[i].top, 0);
+        atomic_init(&deques[i].bottom, 0);
+    }
+    nThreads = threads;
+    rangeLength = rangeSize;
+    searchRange = search;
+    searchArg = arg;
+    atomic_store(&frontier, start);
+
+    for (int i = 0; i < threads; i++) {
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, pool_thread, (void *)(intptr_t)i) != 0) return -1;
+        pthread_detach(tid);
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: pool_park
+Returns: void
+Input: N/A
+Precondition: pool_start() succeeded
+Task: Stops every pool thread at its next range boundary and returns
+  once all of them have stopped, so highest and tested are settled.
+ **************************************************/
+void pool_park(void) {
+    pthread_mutex_lock(&parkLock);
+    atomic_store(&parkRequested, 1);
+    while (parked < nThreads) pthread_cond_wait(&allParked, &parkLock);
+    pthread_mutex_unlock(&parkLock);
+}
+
+/**************************************************
+Method Name: pool_resume
+Returns: void
+Input: N/A
+Precondition: N/A
+Task: Lets parked threads continue. Does nothing if none are parked.
+ **************************************************/
+void pool_resume(void) {
+    pthread_mutex_lock(&parkLock);
+    atomic_store(&parkRequested, 0);
+    pthread_cond_broadcast(&resumed);
+    pthread_mutex_unlock(&parkLock);
+}
+
+/**************************************************
+Method Name: pool_highest
+Returns: uint64_t
+Input: N/A
+Precondition: N/A
+Task: Returns the largest prime found so far.
+ **************************************************/
+uint64_t pool_highest(void) {
+    return atomic_load(&highest);
+}
+
+/**************************************************
+Method Name: pool_tested
+Returns: uint64_t
+Input: N/A
+Precondition: N/A
+Task: Returns how many candidates the finished ranges covered.
+ **************************************************/
+uint64_t pool_tested(void) {
+    return atomic_load(&tested);
+}
+
+/**************************************************
+Method Name: pool_resume_point
+Returns: uint64_t
+Input: N/A
+Precondition: The pool is parked
+Task: Returns the lowest candidate not yet searched: the first range
+  still queued in any deque, or the frontier if none is. Every range below
+  it is finished; some ranges above it may be finished too.
+ **************************************************/
+uint64_t pool_resume_point(void) {
+    uint64_t lowest = atomic_load(&frontier);
+    for (int i = 0; i < nThreads; i++) {
+        int64_t top = atomic_load(&deques[i].top), bottom = atomic_load(&deques[i].bottom);
+        for (int64_t j = top; j < bottom; j++) {
+            uint64_t range = atomic_load(&deques[i].ranges[j & (DEQUE_SIZE - 1)]);
+            if (range < lowest) lowest = range;
+        }
+    }
+    return lowest;
+}
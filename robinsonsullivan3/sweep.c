@@ -0,0 +1,199 @@
+// File: sweep.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "sweep.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define MAX_LINE 1024
+
+// Work queue shared by the pool threads
+static atomic_int nextRun;
+static int totalRuns;
+static SweepRun runFn;
+static void *runCtx;
+
+/**************************************************
+Method Name: add_config
+Returns: int
+Input: char ***configs, int *count, int *cap, const char *line
+Precondition: N/A
+Task: Appends a copy of line to the growing configs array. Returns -1
+  if memory runs out.
+ **************************************************/
+static int add_config(char ***configs, int *count, int *cap, const char *line) {
+    if (*count == *cap) {
+        int newCap = *cap ? *cap * 2 : 16;
+        char **grown = realloc(*configs, sizeof(char *) * (size_t)newCap);
+        if (!grown) return -1;
+        *configs = grown;
+        *cap = newCap;
+    }
+    (*configs)[*count] = strdup(line);
+    if (!(*configs)[*count]) return -1;
+    (*count)++;
+    return 0;
+}
+
+/**************************************************
+Method Name: expand_line
+Returns: int
+Input: const char *line, char ***configs, int *count, int *cap
+Precondition: line is one grid line without its newline
+Task: Expands the first {a|b|...} group in line into one line per
+  alternative and recurses, so every group multiplies the configurations
+  (a cartesian product). A line without groups is added as is.
+ **************************************************/
+static int expand_line(const char *line, char ***configs, int *count, int *cap) {
+    const char *open = strchr(line, '{');
+    const char *close = open ? strchr(open, '}') : NULL;
+    if (!open || !close) return add_config(configs, count, cap, line);
+
+    const char *alt = open + 1;
+    while (alt <= close) {
+        const char *end = alt;
+        while (end < close && *end != '|') end++;
+
+        char expanded[MAX_LINE];
+        int len = snprintf(expanded, sizeof(expanded), "%.*s%.*s%s",
+                           (int)(open - line), line, (int)(end - alt), alt, close + 1);
+        if (len < 0 || len >= (int)sizeof(expanded)) return -1;
+        if (expand_line(expanded, configs, count, cap) != 0) return -1;
+        alt = end + 1;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: sweep_expand_grid
+Returns: int
+Input: const char *path, char ***configs
+Precondition: path is a text file with one set of scheduler options per
+  line, where {a|b|c} lists values to try (blank lines and lines starting
+  with # are skipped)
+Task: Reads the grid and returns the number of configurations stored in
+  *configs, or -1 on error.
+ **************************************************/
+int sweep_expand_grid(const char *path, char ***configs) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror("fopen grid");
+        return -1;
+    }
+
+    char line[MAX_LINE];
+    int count = 0, cap = 0;
+    *configs = NULL;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *start = line;
+        while (*start == ' ' || *start == '\t') start++;
+        if (*start == '#' || *start == '\0') continue;
+        if (expand_line(start, configs, &count, &cap) != 0) {
+            fprintf(stderr, "Grid line too long or out of memory: %s\n", line);
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+/**************************************************
+Method Name: sweep_split
+Returns: int
+Input: char *line, char **argv, int maxArgs
+Precondition: argv has room for maxArgs + 1 entries
+Task: Splits line in place on whitespace into argv[1..], with argv[0]
+  set to "sweep" so the result can be handed to getopt. Returns argc.
+ **************************************************/
+int sweep_split(char *line, char **argv, int maxArgs) {
+    int argc = 0;
+    argv[argc++] = "sweep";
+    for (char *tok = strtok(line, " \t"); tok && argc < maxArgs; tok = strtok(NULL, " \t")) {
+        argv[argc++] = tok;
+    }
+    argv[argc] = NULL;
+    return argc;
+}
+
+/**************************************************
+Method Name: worker
+Returns: void *
+Input: void *arg
+Precondition: sweep_run() set up the work queue
+Task: Takes runs off the shared counter until none are left.
+ **************************************************/
+static void *worker(void *arg) {
+    (void)arg;
+    int run;
+    while ((run = atomic_fetch_add(&nextRun, 1)) < totalRuns) {
+        runFn(run, runCtx);
+    }
+    return NULL;
+}
+
+/**************************************************
+Method Name: sweep_run
+Returns: void
+Input: int nRuns, int threads, SweepRun fn, void *ctx
+Precondition: fn only touches its own run's state and results slot
+Task: Calls fn for every run on a pool of threads (the number of online
+  CPUs if threads < 1) and waits for all of them.
+ **************************************************/
+void sweep_run(int nRuns, int threads, SweepRun fn, void *ctx) {
+    if (threads < 1) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if (threads > nRuns) threads = nRuns > 0 ? nRuns : 1;
+
+    atomic_store(&nextRun, 0);
+    totalRuns = nRuns;
+    runFn = fn;
+    runCtx = ctx;
+
+    pthread_t *pool = malloc(sizeof(pthread_t) * (size_t)threads);
+    int started = 0;
+    for (int t = 0; pool && t < threads; t++) {
+        if (pthread_create(&pool[t], NULL, worker, NULL) != 0) break;
+        started++;
+    }
+    if (started == 0) worker(NULL); // No threads available, run everything here
+    for (int t = 0; t < started; t++) pthread_join(pool[t], NULL);
+    free(pool);
+}
+
+/**************************************************
+Method Name: sweep_write_csv
+Returns: int
+Input: const char *path, char **traces, int nTraces, char **configs,
+  int nConfigs, const SweepResult *results
+Precondition: results holds nConfigs * nTraces entries
+Task: Writes one CSV row per run to path (stdout if path is NULL).
+  Returns 0 on success, -1 if the file cannot be written.
+ **************************************************/
+int sweep_write_csv(const char *path, char **traces, int nTraces, char **configs, int nConfigs, const SweepResult *results) {
+    FILE *out = path ? fopen(path, "w") : stdout;
+    if (!out) {
+        perror("fopen csv");
+        return -1;
+    }
+
+    fprintf(out, "trace,config,finished,jobs,makespan,avg_turnaround,avg_wait,max_wait,dispatches\n");
+    for (int c = 0; c < nConfigs; c++) {
+        for (int t = 0; t < nTraces; t++) {
+            const SweepResult *r = &results[c * nTraces + t];
+            fprintf(out, "%s,\"%s\",%d,%d,%d,%.3f,%.3f,%d,%d\n", traces[t], configs[c], r->ok, r->jobs,
+                    r->makespan, r->avgTurnaround, r->avgWait, r->maxWait, r->dispatches);
+        }
+    }
+
+    if (path) fclose(out);
+    else fflush(out);
+    return 0;
+}
@@ -0,0 +1,29 @@
+// File: sweep.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#define SWEEP_MAX_ARGS 64 // Tokens in one configuration line
+
+// Metrics of one configuration x trace run
+typedef struct {
+    int ok;               // 0 if the run did not finish
+    int jobs;
+    int makespan;         // Tick the last job finished
+    double avgTurnaround; // Mean of finish - arrival
+    double avgWait;       // Mean ticks spent ready but not running
+    int maxWait;
+    int dispatches;       // Times the CPU was given to a different process
+} SweepResult;
+
+// Runs one configuration x trace pair (run = config * nTraces + trace)
+typedef void (*SweepRun)(int run, void *ctx);
+
+int sweep_expand_grid(const char *path, char ***configs);
+int sweep_split(char *line, char **argv, int maxArgs);
+void sweep_run(int nRuns, int threads, SweepRun fn, void *ctx);
+int sweep_write_csv(const char *path, char **traces, int nTraces, char **configs, int nConfigs, const SweepResult *results);
+
+#endif
@@ -0,0 +1,330 @@
+// File: trace.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "trace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TRACE_SPANS 65536
+#define MAX_TRACE_INSTANTS 16384
+#define GANTT_WIDTH 100
+#define TICK_US 1000000LL // One scheduler tick is one second on the timeline
+
+typedef struct {
+    int job;    // Slot in jobs[]
+    int state;  // TRACE_* state held during the span
+    int start;  // First tick of the span
+    int end;    // Tick the span ended
+} Span;
+
+typedef struct {
+    int procNum;
+    int state;  // Current state
+    int since;  // Tick the current state started
+} TraceJob;
+
+// Everything is preallocated by trace_init() so recording never allocates
+// and is safe to call from the timer signal handler.
+static TraceJob *jobs = NULL;
+static int nJobs = 0;
+static int maxTraceJobs = 0;  // The scheduler's job limit, so every job gets a track
+static int *jobIndex = NULL;  // Open-addressed procNum -> slot + 1 (0 is empty), at least twice maxTraceJobs
+static unsigned jobIndexMask = 0;
+static Span *spans = NULL;
+static int nSpans = 0;
+static Span *instants = NULL;  // Preemptions (start == end)
+static int nInstants = 0;
+static int lastTick = 0;
+static int droppedSpans = 0;
+
+/**************************************************
+Method Name: trace_init
+Returns: int
+Input: int maxJobs
+Precondition: Called once before any other trace function
+Task: Allocates the job table for up to maxJobs jobs (the scheduler's own
+  limit), its procNum index and the span buffers. Returns 0 on success,
+  -1 on failure.
+ **************************************************/
+int trace_init(int maxJobs) {
+    unsigned indexSize = 1;
+    while (indexSize < 2 * (unsigned)maxJobs) indexSize <<= 1;
+    jobs = malloc(sizeof(TraceJob) * (size_t)maxJobs);
+    jobIndex = calloc(indexSize, sizeof(int));
+    spans = malloc(sizeof(Span) * MAX_TRACE_SPANS);
+    instants = malloc(sizeof(Span) * MAX_TRACE_INSTANTS);
+    if (!jobs || !jobIndex || !spans || !instants) {
+        free(jobs);
+        free(jobIndex);
+        free(spans);
+        free(instants);
+        jobs = NULL;
+        jobIndex = NULL;
+        spans = instants = NULL;
+        return -1;
+    }
+    maxTraceJobs = maxJobs;
+    jobIndexMask = indexSize - 1;
+    return 0;
+}
+
+/**************************************************
+Method Name: trace_enabled
+Returns: int
+Input: N/A
+Precondition: N/A
+Task: Returns 1 if trace_init() succeeded, so callers can skip recording.
+ **************************************************/
+int trace_enabled(void) {
+    return spans != NULL;
+}
+
+/**************************************************
+Method Name: find_job
+Returns: int
+Input: int procNum
+Precondition: trace_init() was called
+Task: Returns the slot for procNum, adding it on first use. Returns -1
+  if the job table is full. Looks procNum up in jobIndex, which is at
+  most half full, so the tick handler's cost does not grow with the
+  number of jobs.
+ **************************************************/
+static int find_job(int procNum) {
+    unsigned h = ((unsigned)procNum * 2654435761u) & jobIndexMask;
+    while (jobIndex[h]) {
+        int slot = jobIndex[h] - 1;
+        if (jobs[slot].procNum == procNum) return slot;
+        h = (h + 1) & jobIndexMask;
+    }
+    if (nJobs >= maxTraceJobs) return -1;
+
+    jobs[nJobs].procNum = procNum;
+    jobs[nJobs].state = TRACE_NONE;
+    jobs[nJobs].since = 0;
+    jobIndex[h] = nJobs + 1;
+    return nJobs++;
+}
+
+/**************************************************
+Method Name: close_span
+Returns: void
+Input: int job, int tick
+Precondition: job is a valid slot
+Task: Records the job's current state as a span ending at tick.
+ **************************************************/
+static void close_span(int job, int tick) {
+    TraceJob *j = &jobs[job];
+    if (j->state == TRACE_NONE || j->state == TRACE_DONE || tick <= j->since) return;
+
+    if (nSpans >= MAX_TRACE_SPANS) {
+        droppedSpans++;
+        return;
+    }
+    spans[nSpans].job = job;
+    spans[nSpans].state = j->state;
+    spans[nSpans].start = j->since;
+    spans[nSpans].end = tick;
+    nSpans++;
+}
+
+/**************************************************
+Method Name: trace_state
+Returns: void
+Input: int tick, int procNum, int state
+Precondition: Ticks never go backwards
+Task: Moves a job into a new state at tick, closing the span of its
+  previous state. Repeating the current state does nothing.
+ **************************************************/
+void trace_state(int tick, int procNum, int state) {
+    if (!spans) return;
+    int job = find_job(procNum);
+    if (job < 0 || jobs[job].state == state) return;
+
+    close_span(job, tick);
+    jobs[job].state = state;
+    jobs[job].since = tick;
+    if (tick > lastTick) lastTick = tick;
+}
+
+/**************************************************
+Method Name: trace_preempt
+Returns: void
+Input: int tick, int procNum
+Precondition: trace_init() was called
+Task: Records an instant preemption event for the job.
+ **************************************************/
+void trace_preempt(int tick, int procNum) {
+    if (!spans) return;
+    int job = find_job(procNum);
+    if (job < 0 || nInstants >= MAX_TRACE_INSTANTS) return;
+
+    instants[nInstants].job = job;
+    instants[nInstants].state = TRACE_STOPPED;
+    instants[nInstants].start = tick;
+    instants[nInstants].end = tick;
+    nInstants++;
+}
+
+/**************************************************
+Method Name: trace_finish
+Returns: void
+Input: int endTick
+Precondition: The run is over
+Task: Closes the open span of every job at endTick.
+ **************************************************/
+void trace_finish(int endTick) {
+    if (!spans) return;
+    for (int i = 0; i < nJobs; i++) {
+        close_span(i, endTick);
+        jobs[i].since = endTick;
+    }
+    if (endTick > lastTick) lastTick = endTick;
+}
+
+/**************************************************
+Method Name: state_name
+Returns: const char *
+Input: int state
+Precondition: N/A
+Task: Returns the display name of a TRACE_* state.
+ **************************************************/
+static const char *state_name(int state) {
+    switch (state) {
+        case TRACE_READY: return "ready";
+        case TRACE_RUNNING: return "running";
+        case TRACE_STOPPED: return "stopped";
+        case TRACE_IO: return "io";
+        default: return "none";
+    }
+}
+
+/**************************************************
+Method Name: trace_write_json
+Returns: int
+Input: const char *path
+Precondition: trace_finish() was called
+Task: Writes the timeline as Chrome trace-event JSON (loads in
+  chrome://tracing and Perfetto). Process 1 has one track per CPU
+  showing which job ran, process 2 has one track per job showing its
+  state, and preemptions are instant events. Returns 0 on success.
+ **************************************************/
+int trace_write_json(const char *path) {
+    if (!spans) return -1;
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror("fopen trace");
+        return -1;
+    }
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPUs\"}},\n");
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"CPU 0\"}},\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"Jobs\"}}");
+    for (int i = 0; i < nJobs; i++) {
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":%d,\"args\":{\"name\":\"p=%d\"}}",
+                i + 1, jobs[i].procNum);
+        fprintf(f, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":2,\"tid\":%d,\"args\":{\"sort_index\":%d}}",
+                i + 1, i);
+    }
+
+    for (int i = 0; i < nSpans; i++) {
+        Span *s = &spans[i];
+        long long ts = s->start * TICK_US;
+        long long dur = (s->end - s->start) * TICK_US;
+        fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"state\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":2,\"tid\":%d}",
+                state_name(s->state), ts, dur, s->job + 1);
+        if (s->state == TRACE_RUNNING) {
+            fprintf(f, ",\n{\"name\":\"p=%d\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":0}",
+                    jobs[s->job].procNum, ts, dur);
+        }
+    }
+
+    for (int i = 0; i < nInstants; i++) {
+        long long ts = instants[i].start * TICK_US;
+        fprintf(f, ",\n{\"name\":\"preempt p=%d\",\"cat\":\"preempt\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":2,\"tid\":%d}",
+                jobs[instants[i].job].procNum, ts, instants[i].job + 1);
+        fprintf(f, ",\n{\"name\":\"preempt p=%d\",\"cat\":\"preempt\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":1,\"tid\":0}",
+                jobs[instants[i].job].procNum, ts);
+    }
+
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return 0;
+}
+
+/**************************************************
+Method Name: gantt_rank
+Returns: int
+Input: int state
+Precondition: N/A
+Task: Ranks states so a Gantt column that covers several ticks shows
+  the most interesting one (running beats I/O beats waiting).
+ **************************************************/
+static int gantt_rank(int state) {
+    switch (state) {
+        case TRACE_RUNNING: return 4;
+        case TRACE_IO: return 3;
+        case TRACE_STOPPED: return 2;
+        case TRACE_READY: return 1;
+        default: return 0;
+    }
+}
+
+/**************************************************
+Method Name: trace_print_gantt
+Returns: void
+Input: FILE *out
+Precondition: trace_finish() was called
+Task: Prints one row per job with one column per tick (or per group of
+  ticks for long runs): '#' running, 's' stopped, '.' ready, 'i' I/O.
+ **************************************************/
+void trace_print_gantt(FILE *out) {
+    static const char glyph[] = { ' ', '.', '#', 's', 'i', ' ' };
+    if (!spans || nJobs == 0) return;
+
+    int firstTick = lastTick;
+    for (int i = 0; i < nSpans; i++) {
+        if (spans[i].start < firstTick) firstTick = spans[i].start;
+    }
+    int range = lastTick - firstTick;
+    if (range < 1) range = 1;
+
+    int perCol = (range + GANTT_WIDTH - 1) / GANTT_WIDTH;
+    if (perCol < 1) perCol = 1;
+    int cols = (range + perCol - 1) / perCol;
+
+    char *row = malloc((size_t)cols + 1);
+    int *rank = malloc(sizeof(int) * (size_t)cols);
+    if (!row || !rank) {
+        free(row);
+        free(rank);
+        return;
+    }
+
+    fprintf(out, "Gantt chart (from tick %d, %d tick%s per column; # running, s stopped, . ready, i I/O):\n",
+            firstTick, perCol, perCol == 1 ? "" : "s");
+    for (int j = 0; j < nJobs; j++) {
+        memset(row, ' ', (size_t)cols);
+        row[cols] = '\0';
+        memset(rank, 0, sizeof(int) * (size_t)cols);
+
+        for (int i = 0; i < nSpans; i++) {
+            if (spans[i].job != j) continue;
+            for (int t = spans[i].start; t < spans[i].end; t++) {
+                int c = (t - firstTick) / perCol;
+                if (c >= cols) break;
+                if (gantt_rank(spans[i].state) > rank[c]) {
+                    rank[c] = gantt_rank(spans[i].state);
+                    row[c] = glyph[spans[i].state];
+                }
+            }
+        }
+        fprintf(out, "p=%-4d|%s|\n", jobs[j].procNum, row);
+    }
+    if (droppedSpans > 0) fprintf(out, "(%d spans dropped, trace buffer full)\n", droppedSpans);
+
+    free(row);
+    free(rank);
+}
@@ -0,0 +1,28 @@
+// File: trace.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+
+// Job states shown on the timeline
+enum {
+    TRACE_NONE = 0,  // Not arrived yet
+    TRACE_READY,     // Arrived (or back from I/O) and waiting for the CPU
+    TRACE_RUNNING,   // On the CPU
+    TRACE_STOPPED,   // Preempted (child stopped with SIGTSTP) and waiting for the CPU
+    TRACE_IO,        // Blocked in an I/O burst
+    TRACE_DONE       // Finished
+};
+
+int trace_init(int maxJobs);
+int trace_enabled(void);
+void trace_state(int tick, int procNum, int state);
+void trace_preempt(int tick, int procNum);
+void trace_finish(int endTick);
+int trace_write_json(const char *path);
+void trace_print_gantt(FILE *out);
+
+#endif
@@ -0,0 +1,234 @@
+// File: workload.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _GNU_SOURCE
+
+#include "workload.h"
+#include "progress.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CACHE_LINE 64
+
+static const char *kindNames[WORK_KINDS] = { "cpu", "mem", "cache", "io", "mixed" };
+
+/**************************************************
+Method Name: workload_name
+Returns: const char *
+Input: WorkKind kind
+Precondition: kind < WORK_KINDS
+Task: Returns the --kind name of kind.
+ **************************************************/
+const char *workload_name(WorkKind kind) {
+    return kindNames[kind];
+}
+
+/**************************************************
+Method Name: workload_parse
+Returns: int
+Input: const char *spec, Workload *w
+Precondition: N/A
+Task: Reads a --kind argument, "kind" or "kind:size" with an optional K, M
+  or G suffix on the size (mem buffer, cache working set or io write; not
+  for cpu or mixed), into w with every other size at its default. Returns
+  0, or -1 if the spec is malformed.
+ **************************************************/
+int workload_parse(const char *spec, Workload *w) {
+    memset(w, 0, sizeof(*w));
+    w->fd = -1;
+    w->memBytes = WORK_MEM_BYTES;
+    w->cacheBytes = WORK_CACHE_BYTES;
+    w->ioBytes = WORK_IO_BYTES;
+
+    size_t nameLen = strcspn(spec, ":");
+    int kind = 0;
+    while (kind < WORK_KINDS && (strlen(kindNames[kind]) != nameLen || strncmp(spec, kindNames[kind], nameLen) != 0)) {
+        kind++;
+    }
+    if (kind == WORK_KINDS) return -1;
+    w->kind = (WorkKind)kind;
+    if (spec[nameLen] == '\0') return 0;
+    if (w->kind == WORK_CPU || w->kind == WORK_MIXED) return -1;
+
+    char *end;
+    unsigned long long size = strtoull(spec + nameLen + 1, &end, 10);
+    if (*end == 'K') size <<= 10;
+    else if (*end == 'M') size <<= 20;
+    else if (*end == 'G') size <<= 30;
+    if (*end && (end[1] || !strchr("KMG", *end))) return -1;
+    if (end == spec + nameLen + 1) return -1;
+
+    if (w->kind == WORK_MEM) w->memBytes = size;
+    else if (w->kind == WORK_CACHE) w->cacheBytes = size;
+    else w->ioBytes = size;
+    if (w->memBytes < CACHE_LINE || w->cacheBytes < 2 * CACHE_LINE || w->ioBytes < 1 || w->ioBytes > WORK_IO_SPAN) {
+        return -1;
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: build_chain
+Returns: int
+Input: Workload *w
+Precondition: w->nodes holds w->cacheBytes / CACHE_LINE nodes
+Task: Shuffles the nodes (xorshift with a fixed seed, so every run chases
+  the same chain) and links them in that order into one cycle, so the
+  chase visits the whole working set and the hardware prefetcher cannot
+  guess the next line. Returns 0, or -1 if out of memory.
+ **************************************************/
+static int build_chain(Workload *w) {
+    uint32_t count = (uint32_t)(w->cacheBytes / CACHE_LINE);
+    uint32_t *order = malloc(count * sizeof(uint32_t));
+    if (!order) return -1;
+    uint64_t x = 0x9e3779b97f4a7c15ULL;
+    for (uint32_t i = 0; i < count; i++) order[i] = i;
+    for (uint32_t i = count - 1; i > 0; i--) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        uint32_t j = (uint32_t)(x % (i + 1));
+        uint32_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t next = order[(i + 1) % count];
+        memcpy(w->nodes + (size_t)order[i] * CACHE_LINE, &next, sizeof(next));
+    }
+    w->cursor = order[0];
+    free(order);
+    return 0;
+}
+
+/**************************************************
+Method Name: workload_init
+Returns: int
+Input: Workload *w
+Precondition: workload_parse() succeeded
+Task: Sets up what w's kind needs (all of them for mixed): the mem buffer,
+  touched once so page faults stay out of the slices, the cache chain,
+  and for io an unlinked temporary file in $TMPDIR or /tmp. Returns 0, or
+  -1 if an allocation or the file fails.
+ **************************************************/
+int workload_init(Workload *w) {
+    int mixed = w->kind == WORK_MIXED;
+    if (w->kind == WORK_MEM || mixed) {
+        w->buffer = aligned_alloc(CACHE_LINE, (w->memBytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE);
+        if (!w->buffer) return -1;
+        memset(w->buffer, 0, w->memBytes);
+    }
+    if (w->kind == WORK_CACHE || mixed) {
+        w->nodes = aligned_alloc(CACHE_LINE, w->cacheBytes / CACHE_LINE * CACHE_LINE);
+        if (!w->nodes || build_chain(w) < 0) return -1;
+    }
+    if (w->kind == WORK_IO || mixed) {
+        const char *dir = getenv("TMPDIR");
+        char path[256];
+        snprintf(path, sizeof(path), "%s/workerXXXXXX", dir && *dir ? dir : "/tmp");
+        w->fd = mkstemp(path);
+        if (w->fd < 0) return -1;
+        unlink(path);
+        w->block = malloc(w->ioBytes);
+        if (!w->block) return -1;
+        memset(w->block, 'w', w->ioBytes);
+    }
+    return 0;
+}
+
+/**************************************************
+Method Name: workload_next
+Returns: WorkKind
+Input: Workload *w
+Precondition: N/A
+Task: Returns the kind of the next slice: w's own kind, or for mixed the
+  next of cpu, mem, cache and io in turn.
+ **************************************************/
+WorkKind workload_next(Workload *w) {
+    if (w->kind != WORK_MIXED) return w->kind;
+    WorkKind kind = (WorkKind)w->phase;
+    w->phase = (w->phase + 1) % WORK_MIXED;
+    return kind;
+}
+
+/**************************************************
+Method Name: elapsed_ns
+Returns: int64_t
+Input: const struct timespec *start
+Precondition: N/A
+Task: Nanoseconds of CLOCK_MONOTONIC since start.
+ **************************************************/
+static int64_t elapsed_ns(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)(now.tv_sec - start->tv_sec) * 1000000000 + (now.tv_nsec - start->tv_nsec);
+}
+
+/**************************************************
+Method Name: workload_slice
+Returns: void
+Input: Workload *w, WorkKind kind
+Precondition: workload_init() succeeded; for cpu, w->cpuStep is set
+Task: Runs kind for about WORK_SLICE_NS, reading the clock between chunks,
+  and adds what it did to w->done and the progress record:
+  cpu: w->cpuStep (the caller counts and publishes it),
+  mem: read-modify-write passes over the buffer (bytes streamed),
+  cache: dependent loads along the chain (hops),
+  io: writes each followed by fsync, wrapping within WORK_IO_SPAN (synced writes).
+ **************************************************/
+void workload_slice(Workload *w, WorkKind kind) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        if (kind == WORK_CPU) {
+            for (int i = 0; i < WORK_CPU_CHUNK; i++) w->cpuStep(w->cpuArg);
+        } else if (kind == WORK_MEM) {
+            size_t words = w->memBytes / sizeof(uint64_t), chunk = WORK_MEM_CHUNK / sizeof(uint64_t);
+            size_t end = w->memCursor + chunk < words ? w->memCursor + chunk : words;
+            uint64_t *buffer = w->buffer;
+            for (size_t i = w->memCursor; i < end; i++) buffer[i] += i;
+            uint64_t bytes = 2 * (end - w->memCursor) * sizeof(uint64_t);
+            w->memCursor = end == words ? 0 : end;
+            w->done[WORK_MEM] += bytes;
+            progress_work(PROGRESS_STREAMED, bytes);
+        } else if (kind == WORK_CACHE) {
+            uint32_t at = w->cursor;
+            for (int i = 0; i < WORK_CACHE_CHUNK; i++) memcpy(&at, w->nodes + (size_t)at * CACHE_LINE, sizeof(at));
+            w->cursor = at;
+            w->done[WORK_CACHE] += WORK_CACHE_CHUNK;
+            progress_work(PROGRESS_HOPS, WORK_CACHE_CHUNK);
+        } else if (kind == WORK_IO) {
+            if (w->offset + w->ioBytes > WORK_IO_SPAN) w->offset = 0;
+            if (pwrite(w->fd, w->block, w->ioBytes, (off_t)w->offset) != (ssize_t)w->ioBytes || fsync(w->fd) != 0) return;
+            w->offset += w->ioBytes;
+            w->done[WORK_IO]++;
+            progress_work(PROGRESS_SYNCS, 1);
+        }
+    } while (elapsed_ns(&start) < WORK_SLICE_NS);
+}
+
+/**************************************************
+Method Name: workload_format
+Returns: void
+Input: const Workload *w, char *buf, size_t len
+Precondition: N/A
+Task: Writes " streamed=<MB> hops=<n> syncs=<n>" for the kinds w has run
+  (empty for cpu), for the workers' end of run line.
+ **************************************************/
+void workload_format(const Workload *w, char *buf, size_t len) {
+    int n = 0;
+    buf[0] = '\0';
+    if (w->done[WORK_MEM] && n < (int)len) {
+        n += snprintf(buf + n, len - n, " streamed=%lluMB", (unsigned long long)(w->done[WORK_MEM] >> 20));
+    }
+    if (w->done[WORK_CACHE] && n < (int)len) {
+        n += snprintf(buf + n, len - n, " hops=%llu", (unsigned long long)w->done[WORK_CACHE]);
+    }
+    if (w->done[WORK_IO] && n < (int)len) {
+        snprintf(buf + n, len - n, " syncs=%llu", (unsigned long long)w->done[WORK_IO]);
+    }
+}
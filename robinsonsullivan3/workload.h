@@ -0,0 +1,51 @@
+// File: workload.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// What a worker spends its time on (--kind). cpu is the prime search; the
+// others let the schedulers be compared on jobs bound by memory bandwidth,
+// cache misses or synchronous writes. mixed rotates through all four.
+typedef enum { WORK_CPU, WORK_MEM, WORK_CACHE, WORK_IO, WORK_MIXED, WORK_KINDS } WorkKind;
+
+#define WORK_MEM_BYTES (64u << 20)  // Default buffer streamed by mem, well past the last level cache
+#define WORK_CACHE_BYTES (4u << 20) // Default working set chased by cache
+#define WORK_IO_BYTES (4u << 10)    // Default size of each fsync'd write
+#define WORK_IO_SPAN (1u << 20)     // io writes wrap around in the first 1 MB of its file
+#define WORK_SLICE_NS 5000000       // Each slice runs for about 5 ms, so mixed gives every kind the same time
+#define WORK_MEM_CHUNK (256u << 10)  // Bytes streamed between clock reads
+#define WORK_CACHE_CHUNK 1024        // Pointer hops between clock reads
+#define WORK_CPU_CHUNK 16            // cpuStep calls between clock reads
+
+// One step of the caller's prime search, run for the cpu slices of mixed.
+typedef void (*WorkStep)(void *arg);
+
+typedef struct {
+    WorkKind kind;
+    size_t memBytes, cacheBytes, ioBytes; // --kind kind:size sets the one for its kind
+    uint64_t *buffer; // mem: streamed over
+    size_t memCursor; // mem: next word to stream
+    char *nodes;      // cache: one node per cache line, each holding the index of the next
+    uint32_t cursor;  // cache: node the chase is at
+    int fd;           // io: unlinked temporary file
+    char *block;      // io: data for each write
+    size_t offset;    // io: where the next write goes
+    int phase;        // mixed: next kind in the rotation
+    WorkStep cpuStep; // mixed: the prime search, set by the caller
+    void *cpuArg;
+    uint64_t done[WORK_KINDS]; // Bytes streamed, pointer hops and synced writes (by kind; cpu is the caller's)
+} Workload;
+
+int workload_parse(const char *spec, Workload *w);
+int workload_init(Workload *w);
+WorkKind workload_next(Workload *w);
+void workload_slice(Workload *w, WorkKind kind);
+const char *workload_name(WorkKind kind);
+void workload_format(const Workload *w, char *buf, size_t len);
+
+#endif
@@ -11,35 +11,62 @@
 
 #include <pthread.h>
 #include <semaphore.h>
+#include <time.h>
+#include "TimerWheel.h"
+#include "WaitingQueue.h"
 
 #define MAX_STUDENTS 40
 #define MAX_TAXIS 10
+#define MAX_EVENT_TAXIS 64 // Event mode allows more taxis
+#define MAX_CURBS 16
+#define MAX_EVENT_STUDENTS 10000000 // Event mode (-e): students are records, not threads
+#define MAX_WORKERS 64
+#define DEFAULT_WORKERS 4
+#define MAX_CAPACITY 64 // Students one taxi can take (-k)
+#define DEFAULT_CAPACITY 4
 
 extern int numStudents;
 extern int numTaxis;
 extern int maxPartyTime;
+extern int eventMode;
+extern int numWorkers;
+extern int queueKind;
+extern int taxiCapacity;
+extern int departTimeout;
 
-extern int waitingQueue[MAX_STUDENTS];
-extern int front;
-extern int rear;
-extern int count;
+// A curb where one taxi at a time loads, with its own shard of the waiting students
+typedef struct {
+    WaitingQueue queue;  // Students waiting at this curb
+    _Atomic int length;  // About how many are waiting, for picking the shortest queue
+    sem_t loading;       // Held by the taxi loading here
+} Curb;
+
+extern int numCurbs;
+extern Curb curbs[MAX_CURBS];
 
 extern int totalStudentsTaken;
 extern int totalTripsCompleted;
-extern int totalTripsNeeded;
+extern int totalStudentsReserved;
+extern int reservationWaiters;
+extern long totalStolen;
+extern long totalQueueSteps;
 
 extern pthread_t studentThreads[MAX_STUDENTS];
-extern pthread_t taxiThreads[MAX_TAXIS];
+extern pthread_t taxiThreads[MAX_EVENT_TAXIS];
 
 extern sem_t queueMutex;
-extern sem_t curb;
 extern sem_t studentsReady;
+extern sem_t reservationsChanged;
 extern sem_t rideDone[MAX_STUDENTS];
 
+extern StudentRecord *studentRecords;
+extern struct timespec eventStart;
+
 void *studentFunction(void *arg);
 void *taxiFunction(void *arg);
+void *eventWorkerFunction(void *arg);
 void enqueueStudent(int studentID);
-int dequeueStudent(void);
+int dequeueBatch(int curb, int *studentIDs, int k);
 int parseArguments(int argc, char *argv[]);
 
 #endif
@@ -8,21 +8,25 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
+#include <sched.h>
+#include <errno.h>
 #include "Party.h"
 
-// Add a student to the queue
+// Add a student to the shortest curb queue (or, if that shard is full, the
+// next one; together they have a slot for every student)
 void enqueueStudent(int studentID) {
-    waitingQueue[rear] = studentID;
-    rear = (rear + 1) % MAX_STUDENTS;
-    count++;
-}
-
-// Remove a student from the queue
-int dequeueStudent(void) {
-    int studentID = waitingQueue[front];
-    front = (front + 1) % MAX_STUDENTS;
-    count--;
-    return studentID;
+    int shortest = 0;
+    for (int i = 1; i < numCurbs; i++) {
+        if (atomic_load_explicit(&curbs[i].length, memory_order_relaxed) <
+            atomic_load_explicit(&curbs[shortest].length, memory_order_relaxed)) {
+            shortest = i;
+        }
+    }
+    int curb = shortest;
+    while (!queuePush(&curbs[curb].queue, studentID)) {
+        curb = (curb + 1) % numCurbs;
+    }
+    atomic_fetch_add_explicit(&curbs[curb].length, 1, memory_order_relaxed);
 }
 
 // Student thread
@@ -47,9 +51,7 @@ void *studentFunction(void *arg) {
     // Student finishes and joins the taxi queue
     printf("Student %d: I am done partying and waiting for a taxi.\n", studentID);
 
-    sem_wait(&queueMutex);
     enqueueStudent(studentID);
-    sem_post(&queueMutex);
 
     // Signal that a student is ready
     sem_post(&studentsReady);
@@ -60,67 +62,210 @@ void *studentFunction(void *arg) {
     pthread_exit(NULL);
 }
 
+// Event mode: called by a worker's timer wheel when a student is done
+// partying; the student joins the taxi queue
+static void studentDonePartying(uint32_t studentID) {
+    studentRecords[studentID].state = STUDENT_WAITING;
+
+    enqueueStudent((int)studentID);
+
+    sem_post(&studentsReady);
+}
+
+// Milliseconds since the event mode run started
+static uint64_t eventElapsedMs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - eventStart.tv_sec) * 1000 + (uint64_t)((now.tv_nsec - eventStart.tv_nsec) / 1000000);
+}
+
+// Event mode worker thread: draws party times for its share of the students,
+// keeps them in its own timer wheel and sleeps until the next one is due
+void *eventWorkerFunction(void *arg) {
+    int workerID = *((int *)arg);
+    unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)(workerID * 12345);
+    int first = (int)((long long)numStudents * workerID / numWorkers);
+    int last = (int)((long long)numStudents * (workerID + 1) / numWorkers);
+    TimerWheel wheel;
+
+    // Party times are in milliseconds here, up to maxPartyTime seconds
+    wheelInit(&wheel, studentRecords);
+    for (int id = first; id < last; id++) {
+        studentRecords[id].due = maxPartyTime == 0 ? 0 : (uint32_t)(rand_r(&seed) % (maxPartyTime * 1000 + 1));
+        wheelAdd(&wheel, (uint32_t)id);
+    }
+
+    while (wheel.pending > 0) {
+        uint64_t tick = wheelNextTick(&wheel);
+        struct timespec wake = eventStart;
+        wake.tv_sec += (time_t)(tick / 1000);
+        wake.tv_nsec += (long)(tick % 1000) * 1000000;
+        if (wake.tv_nsec >= 1000000000) {
+            wake.tv_sec++;
+            wake.tv_nsec -= 1000000000;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+        wheelAdvance(&wheel, eventElapsedMs(), studentDonePartying);
+    }
+    pthread_exit(NULL);
+}
+
+// Queue operations the calling taxi's last dequeueBatch needed, and how
+// many of its students came from another curb's queue
+static _Thread_local int batchSteps;
+static _Thread_local int batchStolen;
+
+// Take one semaphore unit of studentsReady, giving up at deadline if it is
+// set; 1 if a student was claimed
+static int claimStudent(const struct timespec *deadline) {
+    if (deadline == NULL) {
+        while (sem_wait(&studentsReady) != 0) { }
+        return 1;
+    }
+    while (sem_timedwait(&studentsReady, deadline) != 0) {
+        if (errno != EINTR) return 0;
+    }
+    return 1;
+}
+
+// Claim up to k students for a taxi at curb and take them from its queue in
+// one step. Waits for the first student; the rest are claimed as they
+// arrive until the taxi is full or departTimeout ms have passed (with no
+// timeout, until it is full). Students the curb's own queue does not have
+// are stolen from the other curbs. Returns how many students were taken.
+int dequeueBatch(int curb, int *studentIDs, int k) {
+    struct timespec deadline;
+    int claimed = claimStudent(NULL);
+
+    if (departTimeout > 0) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += departTimeout / 1000;
+        deadline.tv_nsec += (long)(departTimeout % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+    while (claimed < k) {
+        if (sem_trywait(&studentsReady) == 0) {
+            claimed++;
+        } else if (claimStudent(departTimeout > 0 ? &deadline : NULL)) {
+            claimed++;
+        } else {
+            break;
+        }
+    }
+
+    // Every claimed student is in some curb's queue or about to be published there
+    int taken = 0;
+    int shard = curb;
+    batchSteps = 0;
+    batchStolen = 0;
+    while (taken < claimed) {
+        int got = queuePopBatch(&curbs[shard].queue, studentIDs + taken, claimed - taken);
+        batchSteps++;
+        if (got > 0) {
+            atomic_fetch_sub_explicit(&curbs[shard].length, got, memory_order_relaxed);
+            taken += got;
+            if (shard != curb) batchStolen += got;
+        } else {
+            shard = (shard + 1) % numCurbs;
+            if (shard == curb) sched_yield();
+        }
+    }
+    return claimed;
+}
+
 // Taxi thread
 void *taxiFunction(void *arg) {
+    const struct timespec taxiPause = { 0, 1000000 }; // 1 ms between trips in thread mode
     int taxiID = *((int *)arg);
+    int curb = taxiID % numCurbs; // Taxis are spread over the curbs
+    int pickedUp[MAX_CAPACITY];
 
     while (1) {
-        int pickedUp[4];
         int i;
+        int count;
+        int want;
+        int done;
         int totalAfterTrip;
 
         // Wait to access the curb
-        printf("Taxi %d: Waiting to arrive at the curb.\n", taxiID);
-        sem_wait(&curb);
+        if (!eventMode) printf("Taxi %d: Waiting to arrive at the curb.\n", taxiID);
+        sem_wait(&curbs[curb].loading);
 
-        // Check if all required trips are completed
+        // Reserve the students this trip waits for, so taxis loading at other
+        // curbs do not wait for the same last few
         sem_wait(&queueMutex);
-        if (totalTripsCompleted >= totalTripsNeeded) {
-            sem_post(&queueMutex);
-            sem_post(&curb);
-            break;
-        }
+        done = totalStudentsTaken >= numStudents;
+        want = numStudents - totalStudentsReserved;
+        if (want > taxiCapacity) want = taxiCapacity;
+        if (want > 0) totalStudentsReserved += want;
+        else if (!done) reservationWaiters++;
         sem_post(&queueMutex);
+        if (done || want <= 0) {
+            sem_post(&curbs[curb].loading);
+            if (done) break;
+            // The rest are reserved by taxis that may still leave early and give
+            // some back; sleep until the next trip ends, then look again
+            sem_wait(&reservationsChanged);
+            continue;
+        }
 
         // Taxi arrives and begins pickup
-        printf("Taxi %d: I arrived at the curb.\n", taxiID);
-        printf("Taxi %d: Waiting for students...\n", taxiID);
-
-        // Pick up exactly 4 students
-        for (i = 0; i < 4; i++) {
-            sem_wait(&studentsReady);
-            sem_wait(&queueMutex);
-            pickedUp[i] = dequeueStudent();
-            sem_post(&queueMutex);
-
-            // Print current pickup state
-            printf("Taxi %d: I have picked up %d student(s). Student IDs:", taxiID, i + 1);
-            for (int j = 0; j <= i; j++) {
-                printf(" %d", pickedUp[j]);
+        if (!eventMode) {
+            if (numCurbs == 1) printf("Taxi %d: I arrived at the curb.\n", taxiID);
+            else printf("Taxi %d: I arrived at curb %d.\n", taxiID, curb);
+            printf("Taxi %d: Waiting for students...\n", taxiID);
+        }
+
+        // Pick up a full load, or what is left, or what came before the timeout
+        count = dequeueBatch(curb, pickedUp, want);
+        if (!eventMode) {
+            printf("Taxi %d: I have picked up %d student(s). Student IDs:", taxiID, count);
+            for (i = 0; i < count; i++) {
+                printf(" %d", pickedUp[i]);
             }
             printf("\n");
         }
 
-        // Update counters after trip
+        // Update counters after trip, giving back the reservations it did not fill
         sem_wait(&queueMutex);
-        totalStudentsTaken += 4;
+        totalStudentsTaken += count;
+        totalStudentsReserved -= want - count;
         totalTripsCompleted++;
+        totalQueueSteps += batchSteps;
+        totalStolen += batchStolen;
         totalAfterTrip = totalStudentsTaken;
+        // Wake the taxis waiting for reservations to look again
+        while (reservationWaiters > 0) {
+            reservationWaiters--;
+            sem_post(&reservationsChanged);
+        }
         sem_post(&queueMutex);
 
-        // Taxi departs with 4 students
-        printf("Taxi %d: Departing with 4 students. Total students picked up: %d\n", taxiID, totalAfterTrip);
+        // In event mode there are no student threads to wake, and nothing is printed
+        if (eventMode) {
+            for (i = 0; i < count; i++) {
+                studentRecords[pickedUp[i]].state = STUDENT_HOME;
+            }
+            sem_post(&curbs[curb].loading);
+            continue;
+        }
+
+        // Taxi departs with its students
+        printf("Taxi %d: Departing with %d students. Total students picked up: %d\n", taxiID, count, totalAfterTrip);
 
         // Signal each student that their ride is complete
-        for (i = 0; i < 4; i++) {
+        for (i = 0; i < count; i++) {
             sem_post(&rideDone[pickedUp[i]]);
         }
 
         // Release curb for next taxi
-        sem_post(&curb);
+        sem_post(&curbs[curb].loading);
 
         // Small delay to allow other taxis to run
-        usleep(1000);
+        nanosleep(&taxiPause, NULL);
     }
     pthread_exit(NULL);
 }
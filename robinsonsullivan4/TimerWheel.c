@@ -0,0 +1,84 @@
+// File: TimerWheel.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include "TimerWheel.h"
+
+// Empty wheel starting at tick 0
+void wheelInit(TimerWheel *wheel, StudentRecord *students) {
+    wheel->students = students;
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        for (int i = 0; i < WHEEL_SLOTS; i++) {
+            wheel->slot[level][i] = WHEEL_NONE;
+        }
+    }
+    wheel->now = 0;
+    wheel->pending = 0;
+}
+
+// Put a student in the slot for due, which is not before now. The level is
+// the lowest one whose span still holds both now and due, so a student only
+// moves down a level when the wheel reaches the start of its slot.
+static void wheelInsert(TimerWheel *wheel, uint32_t id, uint64_t due) {
+    StudentRecord *student = &wheel->students[id];
+    uint64_t differ = due ^ wheel->now;
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && (differ >> (WHEEL_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    int index = (int)((due >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1));
+    student->next = wheel->slot[level][index];
+    wheel->slot[level][index] = id;
+}
+
+// Add a student whose due tick is set; one due now or earlier expires on the next tick
+void wheelAdd(TimerWheel *wheel, uint32_t id) {
+    uint64_t due = wheel->students[id].due;
+    wheelInsert(wheel, id, due > wheel->now ? due : wheel->now + 1);
+    wheel->pending++;
+}
+
+// The next tick at which a student can expire: the next non-empty slot on
+// level 0, or the start of the next 64 ms block, when a higher level may
+// move students down
+uint64_t wheelNextTick(const TimerWheel *wheel) {
+    uint64_t blockEnd = wheel->now | (WHEEL_SLOTS - 1);
+    for (uint64_t tick = wheel->now + 1; tick <= blockEnd; tick++) {
+        if (wheel->slot[0][tick & (WHEEL_SLOTS - 1)] != WHEEL_NONE) return tick;
+    }
+    return blockEnd + 1;
+}
+
+// Move every student in a slot down to the level its due tick now falls in
+static void wheelCascade(TimerWheel *wheel, int level, int index) {
+    uint32_t id = wheel->slot[level][index];
+    wheel->slot[level][index] = WHEEL_NONE;
+    while (id != WHEEL_NONE) {
+        uint32_t next = wheel->students[id].next;
+        wheelInsert(wheel, id, wheel->students[id].due);
+        id = next;
+    }
+}
+
+// Process every tick up to now, calling expire for each student whose
+// party is over
+void wheelAdvance(TimerWheel *wheel, uint64_t now, void (*expire)(uint32_t id)) {
+    while (wheel->now < now && wheel->pending > 0) {
+        wheel->now++;
+        // At the start of a block, bring the next slot of each higher level down
+        for (int level = 1; level < WHEEL_LEVELS; level++) {
+            if ((wheel->now & ((1ULL << (WHEEL_BITS * level)) - 1)) != 0) break;
+            wheelCascade(wheel, level, (int)((wheel->now >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)));
+        }
+        int index = (int)(wheel->now & (WHEEL_SLOTS - 1));
+        uint32_t id = wheel->slot[0][index];
+        wheel->slot[0][index] = WHEEL_NONE;
+        while (id != WHEEL_NONE) {
+            uint32_t next = wheel->students[id].next;
+            wheel->pending--;
+            expire(id);
+            id = next;
+        }
+    }
+    if (wheel->pending == 0 && wheel->now < now) wheel->now = now;
+}
@@ -0,0 +1,42 @@
+// File: TimerWheel.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+
+// Hierarchical timer wheel with 1 ms ticks: each level has 64 slots and
+// covers 64 times the span of the one below (64 ms, 4.1 s, 4.4 min, 4.7 h).
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 4
+#define WHEEL_NONE 0xffffffffu
+
+// Student states in event mode
+#define STUDENT_PARTYING 0
+#define STUDENT_WAITING 1
+#define STUDENT_HOME 2
+
+// A student in event mode: a record instead of a thread. Students in the
+// same wheel slot are linked through next.
+typedef struct {
+    uint32_t next;  // Next student in the same slot, WHEEL_NONE at the end
+    uint32_t due;   // Tick (ms after the start) when the party ends
+    uint8_t state;  // STUDENT_PARTYING, STUDENT_WAITING or STUDENT_HOME
+} StudentRecord;
+
+typedef struct {
+    StudentRecord *students;               // Shared by every wheel; each wheel links only its own students
+    uint32_t slot[WHEEL_LEVELS][WHEEL_SLOTS]; // First student in each slot
+    uint64_t now;                          // Last tick processed
+    uint64_t pending;                      // Students still in the wheel
+} TimerWheel;
+
+void wheelInit(TimerWheel *wheel, StudentRecord *students);
+void wheelAdd(TimerWheel *wheel, uint32_t id);
+uint64_t wheelNextTick(const TimerWheel *wheel);
+void wheelAdvance(TimerWheel *wheel, uint64_t now, void (*expire)(uint32_t id));
+
+#endif
@@ -0,0 +1,178 @@
+// File: WaitingQueue.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#include <stdlib.h>
+#include "WaitingQueue.h"
+
+// Set up an empty queue for at most capacity students; 0 if out of memory
+int queueInit(WaitingQueue *queue, int kind, int capacity) {
+    queue->kind = kind;
+    queue->front = 0;
+    queue->rear = 0;
+    queue->count = 0;
+    queue->slots = NULL;
+    queue->cells = NULL;
+
+    if (kind == QUEUE_LOCK) {
+        queue->capacity = capacity;
+        queue->slots = malloc((size_t)capacity * sizeof(int));
+        if (queue->slots == NULL) return 0;
+        sem_init(&queue->mutex, 0, 1);
+        return 1;
+    }
+
+    // The ring needs a power of two so a position maps to its slot with a mask
+    uint32_t size = 1;
+    while (size < (uint32_t)capacity) size <<= 1;
+    queue->capacity = (int)size;
+    queue->mask = size - 1;
+    queue->cells = malloc((size_t)size * sizeof(RingCell));
+    if (queue->cells == NULL) return 0;
+    for (uint32_t i = 0; i < size; i++) {
+        atomic_store_explicit(&queue->cells[i].sequence, i, memory_order_relaxed);
+    }
+    atomic_store_explicit(&queue->enqueuePos, 0, memory_order_relaxed);
+    atomic_store_explicit(&queue->dequeuePos, 0, memory_order_relaxed);
+    return 1;
+}
+
+// Free the queue's memory
+void queueDestroy(WaitingQueue *queue) {
+    if (queue->kind == QUEUE_LOCK && queue->slots != NULL) {
+        sem_destroy(&queue->mutex);
+    }
+    free(queue->slots);
+    free(queue->cells);
+    queue->slots = NULL;
+    queue->cells = NULL;
+}
+
+// Add a student at the back; 0 if the queue is full
+int queuePush(WaitingQueue *queue, int studentID) {
+    if (queue->kind == QUEUE_LOCK) {
+        sem_wait(&queue->mutex);
+        if (queue->count == queue->capacity) {
+            sem_post(&queue->mutex);
+            return 0;
+        }
+        queue->slots[queue->rear] = studentID;
+        queue->rear = (queue->rear + 1) % queue->capacity;
+        queue->count++;
+        sem_post(&queue->mutex);
+        return 1;
+    }
+
+    // Claim the slot at enqueuePos once it is free, then publish the student in it
+    uint32_t pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+    while (1) {
+        RingCell *cell = &queue->cells[pos & queue->mask];
+        uint32_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                cell->studentID = studentID;
+                atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0; // The consumer a lap behind has not emptied this slot
+        } else {
+            pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+        }
+    }
+}
+
+// Take the student at the front into *studentID; 0 if there is none yet.
+// A ring slot claimed by a producer that has not published it yet reads
+// as empty, so a caller that knows a student is coming retries.
+int queuePop(WaitingQueue *queue, int *studentID) {
+    if (queue->kind == QUEUE_LOCK) {
+        sem_wait(&queue->mutex);
+        if (queue->count == 0) {
+            sem_post(&queue->mutex);
+            return 0;
+        }
+        *studentID = queue->slots[queue->front];
+        queue->front = (queue->front + 1) % queue->capacity;
+        queue->count--;
+        sem_post(&queue->mutex);
+        return 1;
+    }
+
+    // Claim the slot at dequeuePos once it is full, then free it for the producer a lap ahead
+    uint32_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+    while (1) {
+        RingCell *cell = &queue->cells[pos & queue->mask];
+        uint32_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - (pos + 1));
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *studentID = cell->studentID;
+                atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+        }
+    }
+}
+
+// Take up to max students from the front in one step (one lock, or one
+// compare-and-swap claiming a run of published ring slots). Returns how many
+// were taken, 0 if the front slot is empty or not published yet.
+int queuePopBatch(WaitingQueue *queue, int *studentIDs, int max) {
+    if (queue->kind == QUEUE_LOCK) {
+        sem_wait(&queue->mutex);
+        int taken = queue->count < max ? queue->count : max;
+        for (int i = 0; i < taken; i++) {
+            studentIDs[i] = queue->slots[queue->front];
+            queue->front = (queue->front + 1) % queue->capacity;
+        }
+        queue->count -= taken;
+        sem_post(&queue->mutex);
+        return taken;
+    }
+
+    // Count the published slots from dequeuePos, then claim all of them at once
+    uint32_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+    while (1) {
+        int ready = 0;
+        while (ready < max) {
+            RingCell *cell = &queue->cells[(pos + (uint32_t)ready) & queue->mask];
+            uint32_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+            if (sequence != pos + (uint32_t)ready + 1) break;
+            ready++;
+        }
+        if (ready == 0) {
+            uint32_t now = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed);
+            if (now == pos) return 0;
+            pos = now;
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + (uint32_t)ready,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            for (int i = 0; i < ready; i++) {
+                RingCell *cell = &queue->cells[(pos + (uint32_t)i) & queue->mask];
+                studentIDs[i] = cell->studentID;
+                atomic_store_explicit(&cell->sequence, pos + (uint32_t)i + queue->mask + 1, memory_order_release);
+            }
+            return ready;
+        }
+    }
+}
+
+// Bytes the queue's slots take
+size_t queueBytes(const WaitingQueue *queue) {
+    if (queue->kind == QUEUE_LOCK) return (size_t)queue->capacity * sizeof(int);
+    return (size_t)queue->capacity * sizeof(RingCell);
+}
+
+// Name of a queue kind for -q and the reports
+const char *queueName(int kind) {
+    return kind == QUEUE_LOCK ? "lock" : "ring";
+}
@@ -0,0 +1,51 @@
+// File: WaitingQueue.h
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#ifndef WAITING_QUEUE_H
+#define WAITING_QUEUE_H
+
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Queue implementations (-q)
+#define QUEUE_RING 0 // Bounded lock-free ring, any number of producers and consumers
+#define QUEUE_LOCK 1 // Circular buffer guarded by a binary semaphore
+
+// One ring slot. sequence says whose turn the slot is: equal to the
+// enqueue position when it is free for that producer, one past it when it
+// holds a student for the consumer at that position.
+typedef struct {
+    _Atomic uint32_t sequence;
+    int studentID;
+} RingCell;
+
+// The taxi queue. Both kinds hand out students in the order they were
+// added (for the ring, the order producers claimed their slots).
+typedef struct {
+    int kind;                 // QUEUE_RING or QUEUE_LOCK
+    int capacity;
+    // QUEUE_LOCK
+    int *slots;
+    int front;
+    int rear;
+    int count;
+    sem_t mutex;
+    // QUEUE_RING: capacity is a power of two, positions wrap at 2^32
+    RingCell *cells;
+    uint32_t mask;
+    _Alignas(64) _Atomic uint32_t enqueuePos;
+    _Alignas(64) _Atomic uint32_t dequeuePos;
+} WaitingQueue;
+
+int queueInit(WaitingQueue *queue, int kind, int capacity);
+void queueDestroy(WaitingQueue *queue);
+int queuePush(WaitingQueue *queue, int studentID);
+int queuePop(WaitingQueue *queue, int *studentID);
+int queuePopBatch(WaitingQueue *queue, int *studentIDs, int max);
+size_t queueBytes(const WaitingQueue *queue);
+const char *queueName(int kind);
+
+#endif
@@ -0,0 +1,109 @@
+// File: curbBench.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_COUNTS 16
+#define MAX_RUNS 51
+
+// Parse a comma separated list into counts; returns how many were read
+static int parseList(char *list, int *counts) {
+    int n = 0;
+    for (char *token = strtok(list, ","); token && n < MAX_COUNTS; token = strtok(NULL, ",")) {
+        counts[n++] = atoi(token);
+    }
+    return n;
+}
+
+// Runs ./Party once in event mode and returns its pickups per second, or -1
+// if it failed
+static double runOnce(int students, int curbs, int taxis, int capacity) {
+    char command[256];
+    char line[512];
+    double rate = -1.0;
+
+    snprintf(command, sizeof(command), "./Party -e -s %d -m 0 -c %d -t %d -k %d", students, curbs, taxis, capacity);
+    FILE *party = popen(command, "r");
+    if (party == NULL) return -1.0;
+    while (fgets(line, sizeof(line), party) != NULL) {
+        char *rateText = strstr(line, " seconds, ");
+        if (strncmp(line, "Event mode:", 11) == 0 && rateText != NULL) {
+            rate = atof(rateText + 10);
+        }
+    }
+    if (pclose(party) != 0) return -1.0;
+    return rate;
+}
+
+// For qsort
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    int curbCounts[MAX_COUNTS] = { 1, 2, 4, 8 };
+    int taxiCounts[MAX_COUNTS] = { 1, 2, 4, 8, 16 };
+    int numCurbCounts = 4;
+    int numTaxiCounts = 5;
+    int students = 1000000;
+    int capacity = 4;
+    int runs = 5;
+    int option;
+    int bad = 0;
+
+    while ((option = getopt(argc, argv, "n:r:c:t:k:")) != -1) {
+        switch (option) {
+        case 'n':
+            students = atoi(optarg);
+            break;
+        case 'r':
+            runs = atoi(optarg);
+            break;
+        case 'c':
+            numCurbCounts = parseList(optarg, curbCounts);
+            break;
+        case 't':
+            numTaxiCounts = parseList(optarg, taxiCounts);
+            break;
+        case 'k':
+            capacity = atoi(optarg);
+            break;
+        default:
+            bad = 1;
+        }
+    }
+    if (bad || students < 1 || runs < 1 || runs > MAX_RUNS || numCurbCounts < 1 || numTaxiCounts < 1) {
+        printf("Usage: ./curbBench [-n students] [-r runs] [-k capacity] [-c curbs,curbs,...] [-t taxis,taxis,...]\n");
+        return 1;
+    }
+
+    // One CSV row per curb and taxi count, with the median of the runs.
+    // Taxis are spread over the curbs, so runs with fewer taxis than curbs
+    // leave curbs empty and are skipped.
+    printf("curbs,taxis,capacity,students,cpus,pickups_per_second\n");
+    for (int c = 0; c < numCurbCounts; c++) {
+        for (int t = 0; t < numTaxiCounts; t++) {
+            double rates[MAX_RUNS];
+            if (taxiCounts[t] < curbCounts[c]) continue;
+            for (int r = 0; r < runs; r++) {
+                rates[r] = runOnce(students, curbCounts[c], taxiCounts[t], capacity);
+                if (rates[r] < 0) {
+                    printf("Error: ./Party failed with %d curbs and %d taxis.\n", curbCounts[c], taxiCounts[t]);
+                    return 1;
+                }
+            }
+            qsort(rates, (size_t)runs, sizeof(double), compareDoubles);
+            printf("%d,%d,%d,%d,%ld,%.0f\n", curbCounts[c], taxiCounts[t], capacity, students,
+                   sysconf(_SC_NPROCESSORS_ONLN), rates[runs / 2]);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -6,41 +6,54 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <semaphore.h>
+#include <time.h>
+#include <sys/resource.h>
 #include "Party.h"
 
 // Global configuration values set from command line
 int numStudents = 0;
 int numTaxis = 0;
 int maxPartyTime = 0;
+int eventMode = 0; // -e: students are records in timer wheels instead of threads
+int numWorkers = DEFAULT_WORKERS; // -w: event mode worker threads
+int queueKind = QUEUE_RING; // -q: lock-free ring or semaphore-guarded buffer
+int taxiCapacity = DEFAULT_CAPACITY; // -k: students per taxi
+int departTimeout = 0; // -d: ms a taxi waits to fill up before leaving with fewer (0 waits for a full load)
 
-// Circular queue for waiting students
-int waitingQueue[MAX_STUDENTS];
-int front = 0;
-int rear = 0;
-int count = 0;
+// Curbs, each with its own queue of waiting students (-c)
+int numCurbs = 1;
+Curb curbs[MAX_CURBS];
 
 // Counters to track taxis and students
 int totalStudentsTaken = 0;
 int totalTripsCompleted = 0;
-int totalTripsNeeded = 0;
+int totalStudentsReserved = 0; // Students taxis at a curb are waiting for or have taken
+int reservationWaiters = 0; // Taxis waiting on reservationsChanged
+long totalStolen = 0; // Students taken from another curb's queue
+long totalQueueSteps = 0; // Queue operations the taxis needed, to compare with trips
 
 // Thread arrays for students and taxis
 pthread_t studentThreads[MAX_STUDENTS];
-pthread_t taxiThreads[MAX_TAXIS];
+pthread_t taxiThreads[MAX_EVENT_TAXIS];
 
 // Semaphores for synchronization
-sem_t queueMutex; // protects queue access
-sem_t curb; // ensures one taxi at curb
+sem_t queueMutex; // protects the trip counters
 sem_t studentsReady; // counts waiting students
+sem_t reservationsChanged; // wakes taxis waiting for other taxis to give back reservations
 sem_t rideDone[MAX_STUDENTS]; // signals student picked up
 
+// Event mode students and the time their party times count from
+StudentRecord *studentRecords = NULL;
+struct timespec eventStart;
+
 // Parse and validate command line 
 int parseArguments(int argc, char *argv[]) {
     int option;
 
-    while ((option = getopt(argc, argv, "s:t:m:")) != -1){
+    while ((option = getopt(argc, argv, "s:t:m:ew:q:k:d:c:")) != -1){
         switch (option)
         {
         case 's':
@@ -52,22 +65,67 @@ int parseArguments(int argc, char *argv[]) {
         case 'm':
             maxPartyTime = atoi(optarg);
             break;
+        case 'e':
+            eventMode = 1;
+            break;
+        case 'w':
+            numWorkers = atoi(optarg);
+            break;
+        case 'c':
+            numCurbs = atoi(optarg);
+            break;
+        case 'k':
+            taxiCapacity = atoi(optarg);
+            break;
+        case 'd':
+            departTimeout = atoi(optarg);
+            break;
+        case 'q':
+            if (strcmp(optarg, queueName(QUEUE_RING)) == 0) {
+                queueKind = QUEUE_RING;
+            } else if (strcmp(optarg, queueName(QUEUE_LOCK)) == 0) {
+                queueKind = QUEUE_LOCK;
+            } else {
+                printf("Error: Queue must be ring or lock.\n");
+                return 0;
+            }
+            break;
         default:
             return 0;
         }
     }
 
     // Validate student count
-    if (numStudents <= 0 || numStudents > MAX_STUDENTS) {
+    if (!eventMode && (numStudents <= 0 || numStudents > MAX_STUDENTS)) {
         printf("Error: Number of students must be between 1 and 40.\n");
         return 0;
     }
+    if (eventMode && (numStudents <= 0 || numStudents > MAX_EVENT_STUDENTS)) {
+        printf("Error: Number of students must be between 1 and %d in event mode.\n", MAX_EVENT_STUDENTS);
+        return 0;
+    }
+
+    // Validate worker count
+    if (numWorkers <= 0 || numWorkers > MAX_WORKERS) {
+        printf("Error: Number of workers must be between 1 and %d.\n", MAX_WORKERS);
+        return 0;
+    }
 
     // Validate taxi count
-    if (numTaxis <= 0 || numTaxis > MAX_TAXIS) {
+    if (!eventMode && (numTaxis <= 0 || numTaxis > MAX_TAXIS)) {
         printf("Error: Number of taxis must be between 1 and 10.\n");
         return 0;
     }
+    if (eventMode && (numTaxis <= 0 || numTaxis > MAX_EVENT_TAXIS)) {
+        printf("Error: Number of taxis must be between 1 and %d in event mode.\n", MAX_EVENT_TAXIS);
+        return 0;
+    }
+
+    // Validate curb count
+    if (numCurbs <= 0 || numCurbs > MAX_CURBS) {
+        printf("Error: Number of curbs must be between 1 and %d.\n", MAX_CURBS);
+        return 0;
+    }
 
     // Validate MAX party time
     if (maxPartyTime < 0 || maxPartyTime > 100) {
@@ -75,33 +133,131 @@ int parseArguments(int argc, char *argv[]) {
         return 0;
     }
 
-    // Make sure students can be grouped into taxis of 4
-    if (numStudents % 4 != 0) {
-        printf("Error: Number of students must be divisible by 4.\n");
+    // Validate taxi capacity and departure timeout
+    if (taxiCapacity <= 0 || taxiCapacity > MAX_CAPACITY) {
+        printf("Error: Taxi capacity must be between 1 and %d.\n", MAX_CAPACITY);
+        return 0;
+    }
+    if (departTimeout < 0) {
+        printf("Error: Departure timeout must not be negative.\n");
         return 0;
     }
 
     return 1;
 }
 
+// Set up the curbs. Students go to the shortest queue, so each shard needs
+// about its share of the students; a full shard sends them to the next one.
+static int initCurbs(void) {
+    int share = (numStudents + numCurbs - 1) / numCurbs + 64;
+    for (int i = 0; i < numCurbs; i++) {
+        if (!queueInit(&curbs[i].queue, queueKind, share < numStudents ? share : numStudents)) return 0;
+        atomic_store(&curbs[i].length, 0);
+        sem_init(&curbs[i].loading, 0, 1);
+    }
+    return 1;
+}
+
+// Free the curbs' queues
+static void destroyCurbs(void) {
+    for (int i = 0; i < numCurbs; i++) {
+        queueDestroy(&curbs[i].queue);
+        sem_destroy(&curbs[i].loading);
+    }
+}
+
+// Event mode: a few worker threads run every student's party from timer
+// wheels while the taxis work the queue, then the run is summarized
+static int runEventMode(void) {
+    pthread_t workerThreads[MAX_WORKERS];
+    int workerIDs[MAX_WORKERS];
+    int taxiIDs[MAX_EVENT_TAXIS];
+    struct timespec end;
+    size_t queueMemory = 0;
+    struct rusage usage;
+    int i, home = 0;
+
+    studentRecords = calloc((size_t)numStudents, sizeof(StudentRecord));
+    if (studentRecords == NULL) {
+        printf("Error: Not enough memory for %d students.\n", numStudents);
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &eventStart);
+
+    // Create worker threads
+    for (i = 0; i < numWorkers; i++) {
+        workerIDs[i] = i;
+        pthread_create(&workerThreads[i], NULL, eventWorkerFunction, &workerIDs[i]);
+    }
+
+    // Create taxi threads
+    for (i = 0; i < numTaxis; i++) {
+        taxiIDs[i] = i;
+        pthread_create(&taxiThreads[i], NULL, taxiFunction, &taxiIDs[i]);
+    }
+
+    // Wait for workers and taxis to finish
+    for (i = 0; i < numWorkers; i++) {
+        pthread_join(workerThreads[i], NULL);
+    }
+    for (i = 0; i < numTaxis; i++) {
+        pthread_join(taxiThreads[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // Every student must have been taken home exactly once
+    for (i = 0; i < numStudents; i++) {
+        home += studentRecords[i].state == STUDENT_HOME;
+    }
+    if (home != numStudents) {
+        printf("Error: %d of %d students were taken home.\n", home, numStudents);
+        return 1;
+    }
+
+    for (i = 0; i < numCurbs; i++) {
+        queueMemory += queueBytes(&curbs[i].queue);
+    }
+    double seconds = (end.tv_sec - eventStart.tv_sec) + (end.tv_nsec - eventStart.tv_nsec) / 1e9;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("All students have been taken home.\n");
+    printf("Event mode: %d students, %d workers, %d taxis, %d curbs, %s queue, %.2f seconds, %.0f pickups per second\n",
+           numStudents, numWorkers, numTaxis, numCurbs, queueName(queueKind), seconds, numStudents / seconds);
+    printf("Trips: %d, %.2f students and %.2f queue operations per trip, %ld students taken from another curb\n",
+           totalTripsCompleted, (double)numStudents / totalTripsCompleted, (double)totalQueueSteps / totalTripsCompleted,
+           totalStolen);
+    printf("Memory: %.1f bytes per student (record and queue slots), peak resident %ld MB\n",
+           sizeof(StudentRecord) + (double)queueMemory / numStudents, usage.ru_maxrss / 1024);
+
+    free(studentRecords);
+    destroyCurbs();
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     int i;
     int studentIDs[MAX_STUDENTS];
-    int taxiIDs[MAX_TAXIS];
+    int taxiIDs[MAX_EVENT_TAXIS];
 
     // Parse inputs or exit
     if (!parseArguments(argc, argv)) {
-        printf("Usage: ./Party -s <students> -t <taxis> -m <maxPartyTime>\n");
+        printf("Usage: ./Party -s <students> -t <taxis> -m <maxPartyTime> [-k <capacity>] [-d <timeoutMs>] [-c <curbs>] [-q ring|lock] [-e [-w <workers>]]\n");
         return 1;
     }
 
-    // Compute how many taxi trips are needed
-    totalTripsNeeded = numStudents / 4;
+    // Allocate the curbs and their waiting queues
+    if (!initCurbs()) {
+        printf("Error: Not enough memory for %d students.\n", numStudents);
+        return 1;
+    }
 
     // Initialize semaphores
     sem_init(&queueMutex, 0, 1);
-    sem_init(&curb, 0, 1);
     sem_init(&studentsReady, 0, 0);
+    sem_init(&reservationsChanged, 0, 0);
+
+    if (eventMode) {
+        return runEventMode();
+    }
 
     // Initialize per-student completion semaphores
     for (i = 0; i < numStudents; i++) {
@@ -135,12 +291,13 @@ int main(int argc, char *argv[]) {
 
     // Clean up semaphores
     sem_destroy(&queueMutex);
-    sem_destroy(&curb);
     sem_destroy(&studentsReady);
+    sem_destroy(&reservationsChanged);
 
     for (i = 0; i < numStudents; i++) {
         sem_destroy(&rideDone[i]);
     }
+    destroyCurbs();
 
     return 0;
 }
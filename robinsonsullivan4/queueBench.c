@@ -0,0 +1,162 @@
+// File: queueBench.c
+// Author: Samantha Robinson, Elizabeth Sullivan
+// Date: 18 October 2026
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include "WaitingQueue.h"
+
+#define MAX_BENCH_THREADS 64
+#define MAX_RUNS 51
+
+// Queue variants compared: the taxi queue's two kinds with the studentsReady
+// counting semaphore in front, and the ring alone with consumers polling
+#define VARIANT_LOCK 0
+#define VARIANT_RING 1
+#define VARIANT_RING_POLL 2
+#define VARIANTS 3
+
+static const char *variantNames[VARIANTS] = { "lock", "ring", "ring-poll" };
+
+// One run's shared state
+static WaitingQueue queue;
+static sem_t ready;
+static int variant;
+static int perThread;
+static _Atomic long checksum;
+
+// Producer thread: adds perThread students, like students done partying
+static void *producer(void *arg) {
+    int base = *((int *)arg) * perThread;
+    for (int i = 0; i < perThread; i++) {
+        while (!queuePush(&queue, base + i)) {
+            sched_yield();
+        }
+        if (variant != VARIANT_RING_POLL) sem_post(&ready);
+    }
+    return NULL;
+}
+
+// Consumer thread: takes perThread students, like taxis picking up
+static void *consumer(void *arg) {
+    (void)arg;
+    long sum = 0;
+    for (int i = 0; i < perThread; i++) {
+        int studentID;
+        if (variant != VARIANT_RING_POLL) sem_wait(&ready);
+        while (!queuePop(&queue, &studentID)) {
+            sched_yield();
+        }
+        sum += studentID;
+    }
+    atomic_fetch_add(&checksum, sum);
+    return NULL;
+}
+
+// Runs threads producers and threads consumers over items students in total
+// and returns the seconds it took, or -1 if a student was lost or duplicated
+static double runOnce(int threads, int items) {
+    pthread_t producers[MAX_BENCH_THREADS], consumers[MAX_BENCH_THREADS];
+    int ids[MAX_BENCH_THREADS];
+    struct timespec start, end;
+
+    perThread = items / threads;
+    queueInit(&queue, variant == VARIANT_LOCK ? QUEUE_LOCK : QUEUE_RING, perThread * threads);
+    sem_init(&ready, 0, 0);
+    atomic_store(&checksum, 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < threads; i++) {
+        ids[i] = i;
+        pthread_create(&consumers[i], NULL, consumer, NULL);
+        pthread_create(&producers[i], NULL, producer, &ids[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long total = (long)perThread * threads;
+    long expected = total * (total - 1) / 2;
+    sem_destroy(&ready);
+    queueDestroy(&queue);
+    if (atomic_load(&checksum) != expected) return -1.0;
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// For qsort
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    int threadCounts[MAX_BENCH_THREADS];
+    int numCounts = 0;
+    int items = 1000000;
+    int runs = 5;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:r:t:")) != -1) {
+        switch (option) {
+        case 'n':
+            items = atoi(optarg);
+            break;
+        case 'r':
+            runs = atoi(optarg);
+            break;
+        case 't':
+            numCounts = 0;
+            for (char *token = strtok(optarg, ","); token && numCounts < MAX_BENCH_THREADS; token = strtok(NULL, ",")) {
+                threadCounts[numCounts++] = atoi(token);
+            }
+            break;
+        default:
+            numCounts = -1;
+        }
+    }
+    if (numCounts == 0) {
+        int defaults[] = { 1, 2, 4, 8, 16 };
+        for (numCounts = 0; numCounts < 5; numCounts++) threadCounts[numCounts] = defaults[numCounts];
+    }
+    int bad = numCounts < 0 || items < 1 || runs < 1 || runs > MAX_RUNS;
+    for (int i = 0; i < numCounts && !bad; i++) {
+        bad = threadCounts[i] < 1 || threadCounts[i] > MAX_BENCH_THREADS || threadCounts[i] > items;
+    }
+    if (bad) {
+        printf("Usage: ./queueBench [-n students] [-r runs] [-t threads,threads,...]\n");
+        return 1;
+    }
+
+    // One CSV row per variant and thread count, with the median of the runs
+    printf("queue,producers,consumers,students,cpus,seconds,mops\n");
+    for (int c = 0; c < numCounts; c++) {
+        for (variant = 0; variant < VARIANTS; variant++) {
+            double seconds[MAX_RUNS];
+            for (int r = 0; r < runs; r++) {
+                seconds[r] = runOnce(threadCounts[c], items);
+                if (seconds[r] < 0) {
+                    printf("Error: the %s queue lost or duplicated a student.\n", variantNames[variant]);
+                    return 1;
+                }
+            }
+            qsort(seconds, (size_t)runs, sizeof(double), compareDoubles);
+            double median = seconds[runs / 2];
+            int total = items / threadCounts[c] * threadCounts[c];
+            printf("%s,%d,%d,%d,%ld,%.4f,%.2f\n", variantNames[variant], threadCounts[c], threadCounts[c], total,
+                   sysconf(_SC_NPROCESSORS_ONLN), median, total / median / 1e6);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}